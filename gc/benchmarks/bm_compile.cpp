@@ -0,0 +1,41 @@
+/** @file
+ * @brief Benchmarks of graph compilation.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "synthetic_graph.hpp"
+
+#include "gc/graph_computation.hpp"
+
+#include <benchmark/benchmark.h>
+
+
+namespace gc::bm {
+namespace {
+
+// Compiles a graph with range(0) nodes, each having range(1) inputs.
+static void BM_Compile(benchmark::State& state)
+{
+    auto node_count = static_cast<uint32_t>(state.range(0));
+    auto fan_in = static_cast<WeakPort>(state.range(1));
+    auto g = synthetic_graph(node_count, node_count/10, fan_in);
+
+    for (auto _ : state)
+    {
+        auto compiled = compile(g, {});
+        benchmark::DoNotOptimize(compiled);
+    }
+
+    state.SetComplexityN(static_cast<int64_t>(node_count) * fan_in);
+}
+
+BENCHMARK(BM_Compile)
+    ->ArgsProduct({ { 1'000, 10'000, 100'000 }, { 2, 8 } })
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity(benchmark::oN);
+
+} // anonymous namespace
+} // namespace gc::bm
@@ -0,0 +1,49 @@
+/** @file
+ * @brief Benchmarks of graph computation.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "synthetic_graph.hpp"
+
+#include "gc/graph_computation.hpp"
+
+#include <benchmark/benchmark.h>
+
+
+namespace gc::bm {
+namespace {
+
+// Computes a graph repeatedly, changing one source input of a leaf node
+// before each computation.
+template <bool dirty>
+static void BM_ComputeOneInputChanged(benchmark::State& state)
+{
+    auto node_count = static_cast<uint32_t>(state.range(0));
+    auto g = synthetic_graph(node_count, node_count/10, 2);
+    auto c = computation(g, {});
+    enable_versions(c.source_inputs);
+    compute(c);
+
+    // The leaf node is the last source node: its output is only consumed
+    // by nodes generated after it.
+    auto& value = c.source_inputs.values[node_count/10 - 1].as<int>();
+
+    for (auto _ : state)
+    {
+        ++value;
+        touch(c.source_inputs, node_count/10 - 1);
+        auto ok = dirty
+            ? compute_dirty(c, {}, {})
+            : compute(c, {}, {});
+        benchmark::DoNotOptimize(ok);
+    }
+}
+
+BENCHMARK(BM_ComputeOneInputChanged<false>)->Arg(1'000)->Arg(10'000);
+BENCHMARK(BM_ComputeOneInputChanged<true>)->Arg(1'000)->Arg(10'000);
+
+} // anonymous namespace
+} // namespace gc::bm
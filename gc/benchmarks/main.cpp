@@ -0,0 +1,11 @@
+/** @file
+ * @brief Entry point of graph computation benchmarks.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include <benchmark/benchmark.h>
+
+BENCHMARK_MAIN();
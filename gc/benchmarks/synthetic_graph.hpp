@@ -0,0 +1,100 @@
+/** @file
+ * @brief Synthetic computation graphs for benchmarks.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include "gc/computation_graph.hpp"
+#include "gc/computation_node.hpp"
+#include "gc/node_port_names.hpp"
+
+#include "mpk/mix/value/value.hpp"
+
+#include <cassert>
+#include <random>
+
+
+namespace gc::bm {
+
+// Node with integer inputs, whose single output is the sum of inputs
+class SumNode final
+    : public ComputationNode
+{
+public:
+    explicit SumNode(WeakPort input_count)
+    {
+        input_names_.resize(input_count);
+        output_names_.resize(1);
+    }
+
+    auto input_names() const
+        -> InputNames override
+    { return input_names_(); }
+
+    auto output_names() const
+        -> OutputNames override
+    { return output_names_(); }
+
+    auto default_inputs(InputValues result) const
+        -> void override
+    { std::fill(result.begin(), result.end(), 0); }
+
+    auto compute_outputs(OutputValues result,
+                         ConstInputValues inputs,
+                         const std::stop_token&,
+                         const NodeProgress&) const
+        -> bool override
+    {
+        auto sum = 0;
+        for (const auto& input : inputs)
+            sum += input.as<int>();
+        result.front() = sum;
+        return true;
+    }
+
+private:
+    DynamicInputNames input_names_;
+    DynamicOutputNames output_names_;
+};
+
+// Generates a graph with `source_count` source nodes having one source input
+// each, followed by `node_count - source_count` nodes, each having
+// `fan_in` inputs connected to outputs of randomly chosen preceding nodes.
+inline auto synthetic_graph(uint32_t node_count,
+                            uint32_t source_count,
+                            WeakPort fan_in,
+                            uint32_t seed = 1)
+    -> ComputationGraph
+{
+    assert(source_count > 0);
+    assert(source_count <= node_count);
+
+    auto result = ComputationGraph{};
+    result.nodes.reserve(NodeCount{node_count});
+    result.edges.reserve((node_count - source_count) * fan_in);
+
+    auto gen = std::mt19937{ seed };
+    for (uint32_t i=0; i<node_count; ++i)
+    {
+        if (i < source_count)
+        {
+            result.nodes.push_back(std::make_shared<SumNode>(1));
+            continue;
+        }
+
+        result.nodes.push_back(std::make_shared<SumNode>(fan_in));
+        auto distrib = std::uniform_int_distribution<uint32_t>(0, i-1);
+        for (WeakPort port=0; port<fan_in; ++port)
+            result.edges.push_back({
+                .from = { NodeIndex{distrib(gen)}, OutputPort{0} },
+                .to = { NodeIndex{i}, InputPort{port} } });
+    }
+
+    return result;
+}
+
+} // namespace gc::bm
@@ -0,0 +1,50 @@
+/** @file
+ * @brief Work-stealing thread pool.
+ *
+ * Each worker owns a task queue. Workers take tasks from the back of their
+ * own queues and, when these are empty, steal tasks from the front of queues
+ * owned by other workers.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+
+
+namespace common {
+
+class ThreadPool final
+{
+public:
+    // Tasks must not throw.
+    using Task = std::function<void()>;
+
+    // Zero thread count means the number of hardware threads.
+    explicit ThreadPool(size_t thread_count = 0);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    auto operator=(const ThreadPool&) -> ThreadPool& = delete;
+
+    auto thread_count() const noexcept -> size_t;
+
+    // When called from a worker thread of this pool, the task is pushed to
+    // the queue of that worker; otherwise, queues are chosen round-robin.
+    auto submit(Task task) -> void;
+
+    // Runs queued tasks on the calling thread until `done` returns true.
+    // `done` is checked each time a task of this pool finishes.
+    auto run_until(const std::function<bool()>& done) -> void;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace common
@@ -0,0 +1,87 @@
+/** @file
+ * @brief Amortized checks for stop requests in node computations.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <stop_token>
+#include <utility>
+
+
+namespace gc {
+
+// Number of elements (pixels, sequence items) a node processes between
+// two checks for a stop request. Processing so many elements takes well
+// under a millisecond, and the check costs a tiny fraction of that.
+constexpr size_t cancellation_interval = size_t{1} << 16;
+
+// Returns the number of rows of `width` elements a node processes between
+// two checks for a stop request
+constexpr auto cancellation_rows(size_t width) -> size_t
+{
+    width = std::max<size_t>(width, 1);
+    return std::max<size_t>(cancellation_interval / width, 1);
+}
+
+// Checks for a stop request once per `interval` calls, so that a loop over
+// many small work items (rows, tiles) responds to a stop after a bounded
+// amount of work, without checking on every item. The first call checks.
+class CancellationCheckpoint final
+{
+public:
+    explicit CancellationCheckpoint(std::stop_token stoken,
+                                    size_t interval = 1) noexcept :
+        stoken_{ std::move(stoken) },
+        interval_{ std::max<size_t>(interval, 1) }
+    {}
+
+    // Call once per work item; returns true if a stop has been requested.
+    // Once it returns true, it returns true on each call.
+    auto operator()() noexcept -> bool
+    {
+        if (--countdown_ != 0) [[likely]]
+            return false;
+        stopped_ = stoken_.stop_requested();
+        countdown_ = stopped_ ? 1 : interval_;
+        return stopped_;
+    }
+
+    // Returns true if a call has seen a stop request
+    auto stopped() const noexcept -> bool
+    { return stopped_; }
+
+private:
+    std::stop_token stoken_;
+    size_t interval_;
+    size_t countdown_{ 1 };
+    bool stopped_{};
+};
+
+// Calls `body(begin, end)` for consecutive blocks of [0, n), each of at most
+// `block_size` elements, checking for a stop request before each block.
+// Returns false if a stop has been requested.
+template <std::invocable<size_t, size_t> Body>
+auto for_blocks(size_t n,
+                Body&& body,
+                const std::stop_token& stoken,
+                size_t block_size = cancellation_interval)
+    -> bool
+{
+    block_size = std::max<size_t>(block_size, 1);
+    for (size_t begin=0; begin<n; begin+=block_size)
+    {
+        if (stoken.stop_requested())
+            return false;
+        body(begin, std::min(begin + block_size, n));
+    }
+    return !stoken.stop_requested();
+}
+
+} // namespace gc
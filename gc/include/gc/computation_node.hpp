@@ -11,6 +11,7 @@
 #pragma once
 
 #include "gc/computation_node_fwd.hpp"
+#include "gc/elementwise_kernel.hpp"
 #include "gc/port_values.hpp"
 
 #include "mpk/mix/util/const_name_span.hpp"
@@ -18,7 +19,9 @@
 
 #include <cassert>
 #include <limits>
+#include <optional>
 #include <stop_token>
+#include <string>
 
 
 namespace gc {
@@ -26,6 +29,14 @@ namespace gc {
 using NodeProgress =
     mpk::mix::FuncRef<void(double)>;
 
+// Ports of a node able to compute the output when it is the input value
+// itself, i.e., to transform the input in place.
+struct InPlacePorts final
+{
+    InputPort input;
+    OutputPort output;
+};
+
 struct ComputationNode
 {
     virtual ~ComputationNode() = default;
@@ -42,6 +53,39 @@ struct ComputationNode
                                  const NodeProgress& progress) const
         -> bool = 0;
 
+    // Nodes whose outputs are expensive to compute may opt in to storing
+    // them in the persistent result cache (see `DiskCache`) by returning
+    // a non-empty string identifying the node type and init args.
+    virtual auto persistent_cache_id() const -> std::string
+    { return {}; }
+
+    // Nodes whose outputs are not determined by their inputs alone, e.g.,
+    // ones generating random values or reading files, return false here,
+    // so that their outputs are never memoized by the result cache
+    // (see `ResultCache`).
+    virtual auto cacheable() const -> bool
+    { return true; }
+
+    // Nodes computing an output element by element from a streamed input
+    // may return the ports here and provide the kernel; `compile` can then
+    // fuse chains of such nodes (see `CompileOptions::fuse_elementwise`).
+    virtual auto elementwise_ports() const -> std::optional<ElementwisePorts>
+    { return {}; }
+
+    // Returns the kernel of a node with elementwise ports, for the values of
+    // its inputs other than the streamed one. Called by fused chains instead
+    // of `compute_outputs`.
+    virtual auto elementwise_kernel(ConstInputValues /*inputs*/) const
+        -> ElementwiseKernel
+    { return {}; }
+
+    // Nodes whose `compute_outputs` works when an output and an input refer
+    // to the same value may return the ports here; the engine can then hand
+    // over the storage of the input to the output, instead of having both
+    // (see `CompileOptions::compute_in_place`).
+    virtual auto in_place_ports() const -> std::optional<InPlacePorts>
+    { return {}; }
+
     auto input_count() const -> InputPortCount
     { return input_names().size(); }
 
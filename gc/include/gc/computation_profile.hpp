@@ -0,0 +1,73 @@
+/** @file
+ * @brief Per-node profiling of graph computations.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include "gc/node_index.hpp"
+#include "gc/node_labels.hpp"
+
+#include "mpk/mix/strong/vector.hpp"
+#include "mpk/mix/value/value_fwd.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+
+
+namespace gc {
+
+struct NodeProfile final
+{
+    // Wall time spent computing the node, including result cache lookups
+    std::chrono::nanoseconds time{};
+
+    // Number of times the node has been computed or taken from a cache
+    size_t call_count{};
+
+    // Number of times the node has been skipped because its inputs
+    // have not changed
+    size_t skip_count{};
+
+    // Number of times the node has been computed, but its outputs have
+    // been the same as before, so its consumers have not been recomputed
+    // (see `ComputationResult::fingerprint`)
+    size_t cutoff_count{};
+
+    // Total size of values passed to the node along graph edges
+    uint64_t edge_bytes{};
+};
+
+// Statistics accumulated by computations when set in
+// `ComputationResult::profile`. Computations resize `nodes`
+// to the number of graph nodes.
+struct ComputationProfile final
+{
+    using ValueSize = std::function<size_t(const mpk::mix::value::Value&)>;
+
+    // Estimates sizes of values passed along edges;
+    // if not set, each value has the size `sizeof(Value)`.
+    ValueSize value_size;
+
+    mpk::mix::StrongVector<NodeProfile, NodeIndex> nodes;
+
+    auto total_time() const noexcept -> std::chrono::nanoseconds;
+};
+
+// Prints a table with a row for each node, sorted by time in descending order
+auto print_profile_table(std::ostream& s,
+                         const ComputationProfile& profile,
+                         NodeLabels node_labels)
+    -> void;
+
+auto print_profile_json(std::ostream& s,
+                        const ComputationProfile& profile,
+                        NodeLabels node_labels)
+    -> void;
+
+} // namespace gc
@@ -0,0 +1,147 @@
+/** @file
+ * @brief Helpers for binary files of the persistent cache and snapshots.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace gc::detail {
+
+// Binary files store numbers as 64-bit values in the native byte order,
+// and strings as blocks: the size followed by the bytes padded to 8 bytes.
+
+using FileBytes = std::span<const std::byte>;
+
+inline auto write_u64(std::string& bytes, uint64_t value)
+    -> void
+{ bytes.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+
+inline auto write_block(std::string& bytes, std::string_view data)
+    -> void
+{
+    write_u64(bytes, data.size());
+    bytes.append(data);
+    bytes.append((8 - data.size() % 8) % 8, '\0');
+}
+
+// Reads fields of a binary file; any read past the end of the data
+// makes the reader invalid.
+class FileReader final
+{
+public:
+    explicit FileReader(FileBytes bytes) noexcept :
+        bytes_{ bytes }
+    {}
+
+    auto u64() -> uint64_t
+    {
+        auto result = uint64_t{};
+        if (!take(sizeof(result)))
+            return result;
+        std::memcpy(&result, bytes_.data() + pos_ - sizeof(result),
+                    sizeof(result));
+        return result;
+    }
+
+    auto block() -> FileBytes
+    {
+        auto size = u64();
+        auto begin = pos_;
+        if (!take(size) || !take((8 - size % 8) % 8))
+            return {};
+        return bytes_.subspan(begin, size);
+    }
+
+    auto str() -> std::string_view
+    {
+        auto b = block();
+        return { reinterpret_cast<const char*>(b.data()), b.size() };
+    }
+
+    explicit operator bool() const noexcept
+    { return ok_; }
+
+private:
+    FileBytes bytes_;
+    size_t pos_{};
+    bool ok_{ true };
+
+    auto take(uint64_t size) -> bool
+    {
+        if (!ok_ || size > bytes_.size() - pos_)
+            return ok_ = false;
+        pos_ += size;
+        return true;
+    }
+};
+
+// Read-only memory mapping of a whole file
+class MappedFile final
+{
+public:
+    explicit MappedFile(const std::filesystem::path& path)
+    {
+        auto fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return;
+
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            auto* data =
+                ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED)
+            {
+                data_ = data;
+                size_ = st.st_size;
+            }
+        }
+        ::close(fd);
+    }
+
+    ~MappedFile()
+    {
+        if (data_)
+            ::munmap(data_, size_);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+    auto bytes() const noexcept -> FileBytes
+    { return { static_cast<const std::byte*>(data_), size_ }; }
+
+    // Tells the kernel that the file is going to be read once from
+    // the beginning to the end, so pages are read ahead in large chunks
+    auto advise_sequential() const noexcept -> void
+    {
+        if (data_)
+            ::madvise(data_, size_, MADV_SEQUENTIAL);
+    }
+
+    explicit operator bool() const noexcept
+    { return data_ != nullptr; }
+
+private:
+    void* data_{};
+    size_t size_{};
+};
+
+} // namespace gc::detail
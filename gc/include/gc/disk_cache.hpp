@@ -0,0 +1,159 @@
+/** @file
+ * @brief Persistent content-addressed cache of node computation results.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include "gc/port_values.hpp"
+
+#include "mpk/mix/value/type.hpp"
+#include "mpk/mix/value/value.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+
+namespace gc {
+
+// Stores outputs of nodes that opt in with
+// `ComputationNode::persistent_cache_id` in files of a cache directory.
+// The file name is the hash of the key composed of the node id and encoded
+// input values; the file contains the key and encoded output values.
+// On a hit, the file is memory-mapped, and output values are decoded
+// from the mapped bytes.
+//
+// Values are encoded by codecs registered for their types; codecs for
+// arithmetic types, vectors of them, and strings are registered by the
+// constructor. Nodes with an input or output of a type having no codec
+// are not cached.
+//
+// The total size of cache files is bounded by the capacity; least recently
+// used files are removed first. Failing to write a cache file is not
+// an error; the outputs are just not cached.
+//
+// The cache is thread safe; codecs have to be added before it is used
+// by concurrent computations.
+class DiskCache final
+{
+public:
+    using Value = mpk::mix::value::Value;
+    using Bytes = std::span<const std::byte>;
+
+    struct Codec final
+    {
+        // Identifies the encoding in cache files
+        std::string name;
+
+        const mpk::mix::value::Type* type;
+
+        // Appends the encoded value to `bytes`
+        std::function<void(const Value& value, std::string& bytes)> encode;
+
+        std::function<Value(Bytes bytes)> decode;
+    };
+
+    DiskCache(std::filesystem::path dir, uint64_t capacity);
+
+    ~DiskCache();
+
+    DiskCache(const DiskCache&) = delete;
+    auto operator=(const DiskCache&) -> DiskCache& = delete;
+
+    auto add_codec(Codec codec) -> void;
+
+    // Returns a codec copying the bytes of a value of a trivially copyable
+    // type `T`, or the elements of a vector of such values.
+    template <typename T>
+    static auto trivial_codec(std::string name) -> Codec;
+
+    // Copies cached outputs of the node identified by `node_id` computed for
+    // `inputs` to `outputs`; returns false if there are no such outputs
+    // in the cache.
+    auto find(std::string_view node_id,
+              ConstInputValues inputs,
+              OutputValues outputs)
+        -> bool;
+
+    // Stores `outputs` computed by the node identified by `node_id`
+    // for `inputs`.
+    auto insert(std::string_view node_id,
+                ConstInputValues inputs,
+                OutputValues outputs)
+        -> void;
+
+    auto dir() const noexcept -> const std::filesystem::path&;
+
+    auto capacity() const noexcept -> uint64_t;
+
+    // Total size of cache files
+    auto size() const -> uint64_t;
+
+    auto hit_count() const -> size_t;
+
+    auto miss_count() const -> size_t;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+
+template <typename T>
+auto DiskCache::trivial_codec(std::string name) -> Codec
+{
+    auto append = [](std::string& bytes, const void* data, size_t size)
+    { bytes.append(static_cast<const char*>(data), size); };
+
+    if constexpr (requires { typename T::value_type; })
+    {
+        using E = typename T::value_type;
+        static_assert(std::same_as<T, std::vector<E>>);
+        static_assert(std::is_trivially_copyable_v<E>);
+        return {
+            .name = std::move(name),
+            .type = mpk::mix::value::type_of<T>(),
+            .encode = [=](const Value& value, std::string& bytes)
+            {
+                const auto& v = value.as<T>();
+                append(bytes, v.data(), v.size() * sizeof(E));
+            },
+            .decode = [](Bytes bytes) -> Value
+            {
+                auto v = T(bytes.size() / sizeof(E));
+                std::memcpy(v.data(), bytes.data(), v.size() * sizeof(E));
+                return v;
+            } };
+    }
+    else
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        return {
+            .name = std::move(name),
+            .type = mpk::mix::value::type_of<T>(),
+            .encode = [=](const Value& value, std::string& bytes)
+            { append(bytes, &value.as<T>(), sizeof(T)); },
+            .decode = [](Bytes bytes) -> Value
+            {
+                auto v = T{};
+                if (bytes.size() == sizeof(T))
+                    std::memcpy(&v, bytes.data(), sizeof(T));
+                return v;
+            } };
+    }
+}
+
+} // namespace gc
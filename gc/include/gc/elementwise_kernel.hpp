@@ -0,0 +1,71 @@
+/** @file
+ * @brief Kernels of nodes computing outputs element by element.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include "gc/port.hpp"
+
+#include "mpk/mix/value/value.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <stop_token>
+
+
+namespace gc {
+
+// Ports of a node whose output element `i` depends only on input element
+// `i` (the input is streamed) and on other inputs of the node.
+struct ElementwisePorts final
+{
+    InputPort input;
+    OutputPort output;
+};
+
+// Elementwise transformation performed by a node, with values of its
+// other inputs bound.
+struct ElementwiseKernel final
+{
+    using Value = mpk::mix::value::Value;
+
+    // Size of one element of the streamed input, in bytes
+    size_t input_element_size;
+
+    // Size of one element of the output, in bytes
+    size_t output_element_size;
+
+    // Transforms `count` input elements into `count` output elements
+    std::function<void(const std::byte* input, std::byte* output, size_t count)>
+        apply;
+
+    // Returns elements of the streamed input value and its shape, i.e.,
+    // whatever is needed to create an output of the same shape (e.g., image
+    // size). Used when the node heads a fused chain.
+    std::function<std::span<const std::byte>(const Value& input, Value& shape)>
+        input_elements;
+
+    // Makes `output` a value of the shape returned by `input_elements` of
+    // the chain head, reusing it where possible, and returns its elements.
+    // Used when the node ends a fused chain.
+    std::function<std::span<std::byte>(Value& output, const Value& shape)>
+        output_elements;
+};
+
+// Computes the output of a fused chain of kernels for the streamed input
+// of the first kernel, without storing intermediate values: elements are
+// passed through all kernels tile by tile, so that intermediate tiles stay
+// in cache, and tiles are processed in parallel on the shared thread pool.
+// Returns false if a stop has been requested.
+auto compute_elementwise_chain(std::span<const ElementwiseKernel> kernels,
+                               const mpk::mix::value::Value& input,
+                               mpk::mix::value::Value& output,
+                               const std::stop_token& stoken)
+    -> bool;
+
+} // namespace gc
@@ -11,6 +11,8 @@
 #pragma once
 
 #include "gc/activation_graph.hpp"
+#include "gc/computation_graph.hpp"
+#include "gc/computation_profile.hpp"
 #include "gc/node_labels.hpp"
 
 #include <ostream>
@@ -23,4 +25,12 @@ auto generate_dot(std::ostream& s,
                   gc::NodeLabels node_labels)
     -> void;
 
+// Generates a computation graph with nodes filled with colors ranging
+// from white to red, depending on their shares in the total computation time.
+auto generate_dot(std::ostream& s,
+                  const gc::ComputationGraph& g,
+                  gc::NodeLabels node_labels,
+                  const gc::ComputationProfile& profile)
+    -> void;
+
 } // namespace gc
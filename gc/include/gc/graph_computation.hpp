@@ -11,7 +11,9 @@
 #pragma once
 
 #include "gc/computation_graph.hpp"
+#include "gc/memory_plan.hpp"
 #include "gc/source_inputs.hpp"
+#include "gc/value_fingerprint.hpp"
 #include "mpk/mix/value/value.hpp"
 
 #include "mpk/mix/func_ref/fwd.hpp"
@@ -19,35 +21,168 @@
 #include "mpk/mix/strong/vector.hpp"
 #include "mpk/mix/util/detail/hash.hpp"
 
+#include <memory>
+#include <optional>
+#include <span>
 #include <stop_token>
 #include <unordered_set>
+#include <vector>
 
 
+namespace common {
+class ThreadPool;
+} // namespace common
+
 namespace gc {
 
 struct ComputationInstructions;
+class DiskCache;
+struct ComputationProfile;
+class ResultCache;
 using ComputationInstructionsPtr = std::shared_ptr<ComputationInstructions>;
 auto operator<<(std::ostream& s, const ComputationInstructions& instructions)
     -> std::ostream&;
 
 // -----------
 
+struct CompileOptions final
+{
+    // If set, chains of nodes with elementwise ports (see
+    // `ComputationNode::elementwise_ports`), each consuming the only
+    // output of the previous one, are computed by a single pass over tiles
+    // of elements (see `compute_elementwise_chain`) when the last node of
+    // the chain is computed. Outputs of other nodes of the chain are not
+    // computed at all, so they must have no other consumers.
+    bool fuse_elementwise{};
+
+    // Outputs that must be computed even if they can be fused, e.g., ones
+    // displayed by a GUI or used as feedback sources.
+    std::vector<EdgeOutputEnd> keep_outputs;
+
+    // Inputs expected to change in most computations, e.g., evolution
+    // feedback sinks. If not empty, nodes not downstream of these inputs
+    // are considered static: `compute` skips them, without even checking
+    // timestamps, as long as they have been computed by the previous
+    // computation and none of them has updated inputs (constant folding).
+    // Editing an input of a static node makes the next computation visit
+    // all nodes again.
+    std::vector<EdgeInputEnd> variable_inputs;
+
+    // If set, intermediate outputs (ones having consumers and not listed
+    // in `keep_outputs`) are released as soon as they are no longer needed,
+    // and their storage is reused by outputs computed later (see
+    // `MemoryPlan`). Nodes with released outputs are recomputed by each
+    // computation, so this trades incremental evaluation for memory; also,
+    // computations are not considered complete (see
+    // `ComputationResult::complete_ts`).
+    bool plan_memory{};
+
+    // If set, a node with in-place ports (see
+    // `ComputationNode::in_place_ports`) takes over the upstream output
+    // connected to its in-place input and computes its output in it,
+    // provided the upstream output goes nowhere else: it has no other
+    // consumers, it is not listed in `keep_outputs`, the input is not
+    // a variable input, and neither node is fused. Taking over does not
+    // happen when the result has caches, or when the input has been updated
+    // manually. Like released outputs (see `plan_memory`), nodes with taken
+    // outputs are recomputed by each computation, and computations are not
+    // considered complete.
+    bool compute_in_place{};
+};
+
 auto compile(const ComputationGraph& g,
-             const SourceInputs& provided_inputs = {})
+             const SourceInputs& provided_inputs = {},
+             const CompileOptions& options = {})
     -> std::pair<ComputationInstructionsPtr, SourceInputs>;
 
+// Returns the memory plan of compiled instructions, or null if it has not
+// been requested (see `CompileOptions::plan_memory`)
+auto memory_plan(const ComputationInstructions& instructions)
+    -> const MemoryPlan*;
+
 using Timestamp = uint64_t;
 
 struct ComputationResult final
 {
+    // Values of node inputs not bound to upstream node outputs, i.e.,
+    // source inputs and inputs updated manually (see `updated_inputs`).
     mpk::mix::StrongGrouped<mpk::mix::value::Value, NodeIndex, InputPort> inputs;
     mpk::mix::StrongGrouped<mpk::mix::value::Value, NodeIndex, OutputPort> outputs;
-    mpk::mix::StrongGrouped<mpk::mix::value::Value, NodeIndex, OutputPort> prev_source_outputs;
     mpk::mix::StrongVector<Timestamp, NodeIndex> node_ts;
+
+    // Timestamp of the computation that last changed outputs of each node;
+    // consumers are recomputed when it is newer than their `node_ts`.
+    // Equals `node_ts` unless the node has been recomputed with the same
+    // outputs (see `fingerprint`).
+    mpk::mix::StrongVector<Timestamp, NodeIndex> changed_ts;
+
     Timestamp computation_ts{};
 
+    // Timestamp of the last computation that has not been interrupted
+    Timestamp complete_ts{};
+
+    // If set, outputs of nodes are looked up in the cache before computing
+    // them, and stored in the cache after computing them.
+    std::shared_ptr<ResultCache> cache;
+
+    // If set, outputs of nodes opting in with
+    // `ComputationNode::persistent_cache_id` are also looked up in and stored
+    // to the persistent cache.
+    std::shared_ptr<DiskCache> disk_cache;
+
+    // If set, computations accumulate per-node statistics in it
+    std::shared_ptr<ComputationProfile> profile;
+
+    // If set, outputs of each computed node are hashed. When the hash is
+    // the same as after the previous computation of the node, its outputs
+    // are considered unchanged, and its consumers are not recomputed
+    // because of it (early cutoff). Nodes having outputs the function
+    // cannot hash are always considered changed.
+    ValueFingerprint fingerprint;
+
+    // Hashes of outputs of each node (see `fingerprint`); zero if unknown
+    mpk::mix::StrongVector<uint64_t, NodeIndex> output_fingerprints;
+
+    // Storage of outputs released according to the memory plan, one
+    // element per buffer (see `MemoryPlan`); handed over to the next output
+    // planned in the same buffer.
+    std::vector<mpk::mix::value::Value> spare_buffers;
+
+    // Versions of source inputs at the moment they were last set to
+    // node inputs; used if `SourceInputs::versions` is not empty.
+    std::vector<SourceInputVersion> source_versions;
+
+    // If not empty, contains an element for each node, and nodes with
+    // false elements are not computed: their outputs and timestamps remain
+    // unchanged. Set by `request_outputs`; when the set of active nodes
+    // changes, the result is made incomplete (see `complete_ts`), so
+    // the next `compute_dirty` checks all nodes.
+    std::vector<bool> active_nodes;
+
     // Used when there is a feedback determining state evolution
     std::unordered_set<EdgeInputEnd, mpk::mix::detail::Hash> updated_inputs;
+
+    // Values passed to nodes as inputs. Each element points either to the
+    // corresponding element of `inputs`, or to the upstream node output
+    // the input is connected to, so edges never copy values.
+    mpk::mix::StrongGrouped<
+        const mpk::mix::value::Value*, NodeIndex, InputPort> input_refs;
+
+    // Data of `inputs` at the moment `input_refs` were bound; allows to
+    // detect that the result has been copied and needs to be rebound.
+    const mpk::mix::value::Value* input_refs_base{};
+
+    // Scratch data of the current computation. A node has updated inputs
+    // if its `updated_ts` element equals `computation_ts`; such nodes are
+    // also listed in `updated_nodes`. Similarly, `visited_ts` marks nodes
+    // visited by `compute_dirty`, and `frontier` is its heap of nodes
+    // to visit. `input_updated_ts` marks elements of `updated_inputs`,
+    // in the flat array of all inputs.
+    mpk::mix::StrongVector<Timestamp, NodeIndex> updated_ts;
+    mpk::mix::StrongVector<Timestamp, NodeIndex> visited_ts;
+    std::vector<Timestamp> input_updated_ts;
+    std::vector<NodeIndex> updated_nodes;
+    std::vector<NodeIndex> frontier;
 };
 
 auto compute(ComputationResult& result,
@@ -59,6 +194,9 @@ auto compute(ComputationResult& result,
 using GraphProgress =
     mpk::mix::FuncRef<void(NodeIndex inode, double node_progress)>;
 
+// Returns false if the computation has been interrupted by `stoken`.
+// The node being computed at that moment is made outdated, since its outputs
+// may be partially overwritten, so the next computation recomputes it.
 auto compute(ComputationResult& result,
              const ComputationGraph& g,
              const ComputationInstructions* instructions,
@@ -67,6 +205,54 @@ auto compute(ComputationResult& result,
              const GraphProgress& progress)
     -> bool;
 
+// Dataflow version of `compute`: each node is started on the thread pool as
+// soon as all nodes supplying data to it have finished. The calling thread
+// participates in the computation until it is done. Note that `progress`
+// may be called concurrently from different threads.
+auto compute(ComputationResult& result,
+             const ComputationGraph& g,
+             const ComputationInstructions* instructions,
+             const SourceInputs& source_inputs,
+             const std::stop_token& stoken,
+             const GraphProgress& progress,
+             common::ThreadPool& pool)
+    -> bool;
+
+// Incremental version of `compute`: only nodes reachable from nodes with
+// updated source inputs or `updated_inputs` are visited, and only edges coming
+// to them are transferred, so the cost of a computation depends on the size
+// of the change rather than on the size of the graph. Falls back to `compute`
+// for the first computation, after a reset (zero `computation_ts`), and after
+// an interrupted computation.
+auto compute_dirty(ComputationResult& result,
+                   const ComputationGraph& g,
+                   const ComputationInstructions* instructions,
+                   const SourceInputs& source_inputs,
+                   const std::stop_token& stoken,
+                   const GraphProgress& progress)
+    -> bool;
+
+// Restricts computations of `result` to the nodes the requested `outputs`
+// depend on, i.e., to the nodes of `outputs` and all nodes upstream of them,
+// by setting `result.active_nodes`. Outputs of other nodes are left as they
+// are, and are brought up to date once they are requested again.
+auto request_outputs(ComputationResult& result,
+                     const ComputationGraph& g,
+                     const ComputationInstructions* instructions,
+                     std::span<const EdgeOutputEnd> outputs)
+    -> void;
+
+// Lifts the restriction set by `request_outputs`, so all nodes are computed
+auto request_all_outputs(ComputationResult& result)
+    -> void;
+
+// Makes all nodes of `result` outdated, so the next computation starts
+// from scratch, as if `result` has just been allocated. Timestamps and
+// scratch data are cleared; values are kept, so their storage can be
+// reused by nodes.
+auto reset_result(ComputationResult& result)
+    -> void;
+
 struct Computation final
 {
     ComputationGraph graph;
@@ -75,10 +261,12 @@ struct Computation final
     ComputationResult result;
 };
 
-inline auto computation(ComputationGraph g, const SourceInputs& provided_inputs)
+inline auto computation(ComputationGraph g,
+                        const SourceInputs& provided_inputs,
+                        const CompileOptions& options = {})
     -> Computation
 {
-    auto [instr, source_inputs] = compile(g, provided_inputs);
+    auto [instr, source_inputs] = compile(g, provided_inputs, options);
 
     return {
         .graph = std::move(g),
@@ -86,6 +274,18 @@ inline auto computation(ComputationGraph g, const SourceInputs& provided_inputs)
         .source_inputs = source_inputs };
 }
 
+// Moves results of the previous computation `prev` to `c`, a computation
+// of an edited version of the same graph, e.g., one with nodes or edges
+// added or removed. `prev_nodes` contains, for each node of `c.graph`,
+// the index of the same node in `prev.graph`, or nothing if the node is new.
+// Outputs and timestamps of nodes having the same ports and incoming edges
+// from other adopted nodes are taken over, so only new and rewired nodes,
+// and nodes downstream of them, are recomputed by `c`.
+auto adopt_result(Computation& c,
+                  Computation prev,
+                  std::span<const std::optional<NodeIndex>> prev_nodes)
+    -> void;
+
 inline auto compute(Computation& c)
     -> void
 { compute(c.result, c.graph, c.instr.get(), c.source_inputs); }
@@ -103,4 +303,37 @@ inline auto compute(Computation& c,
                    progress);
 }
 
+inline auto compute(Computation& c,
+                    const std::stop_token& stoken,
+                    const GraphProgress& progress,
+                    common::ThreadPool& pool)
+    -> bool
+{
+    return compute(c.result,
+                   c.graph,
+                   c.instr.get(),
+                   c.source_inputs,
+                   stoken,
+                   progress,
+                   pool);
+}
+
+inline auto compute_dirty(Computation& c,
+                          const std::stop_token& stoken,
+                          const GraphProgress& progress)
+    -> bool
+{
+    return compute_dirty(c.result,
+                         c.graph,
+                         c.instr.get(),
+                         c.source_inputs,
+                         stoken,
+                         progress);
+}
+
+inline auto request_outputs(Computation& c,
+                            std::span<const EdgeOutputEnd> outputs)
+    -> void
+{ request_outputs(c.result, c.graph, c.instr.get(), outputs); }
+
 } // namespace gc
@@ -0,0 +1,65 @@
+/** @file
+ * @brief Evolution of graph state via feedback from node outputs to inputs.
+ *
+ * Copyright (C) 2025-2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include "gc/computation_graph.hpp"
+#include "gc/edge.hpp"
+
+#include <vector>
+
+
+namespace gc {
+
+struct ComputationResult;
+
+// Before each evolution step, the value of the source output
+// is copied to each of the sink inputs.
+//
+// If `swap_buffers` is set, the value is moved to the last sink rather than
+// copied, and the source output receives the previous value of that sink,
+// so a step costs O(1) and a node reusing its output storage (see
+// `output_slot`) writes the next state into the buffer of the previous one.
+// This is only valid if the source node is recomputed on each step, i.e.,
+// depends on a sink; `make_evolution_feedback` checks that. With the early
+// cutoff (`ComputationResult::fingerprint` is set), the source may be left
+// as is, so `set_feedback` copies the value regardless of `swap_buffers`.
+struct EvolutionFeedback final
+{
+    EdgeOutputEnd source;
+    std::vector<EdgeInputEnd> sinks;
+    bool swap_buffers{};
+};
+
+struct GraphEvolution final
+{
+    std::vector<EvolutionFeedback> feedback;
+};
+
+// Returns feedback with `swap_buffers` set if the source node
+// is reachable from a sink node along graph edges.
+auto make_evolution_feedback(const ComputationGraph& g,
+                             EdgeOutputEnd source,
+                             std::vector<EdgeInputEnd> sinks)
+    -> EvolutionFeedback;
+
+// Prepares an evolution step: copies values along feedback edges and adds
+// sink inputs to `result.updated_inputs`, so the next computation uses
+// the copied values and recomputes nodes depending on them. Feedback from
+// an outdated source node (e.g., one whose computation has been interrupted,
+// see `compute_dirty`) is skipped: the source output is not valid, and
+// the next computation recomputes the source from the current sink values.
+auto set_feedback(ComputationResult& result, const GraphEvolution& evolution)
+    -> void;
+
+// Makes inputs updated by `set_feedback` bound to upstream outputs again;
+// to be called after the last evolution step.
+auto clear_feedback(ComputationResult& result)
+    -> void;
+
+} // namespace gc
@@ -0,0 +1,56 @@
+/** @file
+ * @brief Plan of storage of intermediate node outputs.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include "gc/edge.hpp"
+#include "gc/node_index.hpp"
+#include "gc/port.hpp"
+
+#include "mpk/mix/strong/grouped.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+
+namespace gc {
+
+// Describes when intermediate node outputs die, and which outputs share
+// storage (see `CompileOptions::plan_memory`). Outputs having no consumers
+// and outputs explicitly kept live as long as the computation result does.
+// Any other output is released once all nodes of the level of its last
+// consumer have been computed, and its storage (buffer) is handed over
+// to an output computed at a later level.
+struct MemoryPlan final
+{
+    static constexpr uint32_t no_buffer = ~uint32_t{};
+
+    // Buffer of each output, or `no_buffer` if the output is kept
+    mpk::mix::StrongGrouped<uint32_t, NodeIndex, OutputPort> buffers;
+
+    // Outputs released after each level of the computation
+    mpk::mix::Grouped<EdgeOutputEnd> releases;
+
+    // Number of buffers shared by released outputs
+    uint32_t buffer_count{};
+
+    // Numbers of all outputs and of kept outputs
+    size_t output_count{};
+    size_t kept_output_count{};
+
+    // Maximum number of outputs alive at the same time, kept ones included;
+    // this is the static estimate of peak memory, in output buffers.
+    size_t peak_live_outputs{};
+};
+
+// Prints plan statistics in one line
+auto operator<<(std::ostream& s, const MemoryPlan& plan)
+    -> std::ostream&;
+
+} // namespace gc
@@ -0,0 +1,43 @@
+/** @file
+ * @brief Reuse of node output values between computations.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include "mpk/mix/value/type.hpp"
+#include "mpk/mix/value/value.hpp"
+
+#include <concepts>
+#include <utility>
+
+
+namespace gc {
+
+// Returns the object of type `T` held by the node output `out`, so that
+// a node can overwrite the result of its previous computation instead of
+// allocating a new one. If `out` holds no object of type `T`, or `reusable`
+// returns false for the object it holds, `out` is set to `make()` first.
+template <typename T,
+          std::predicate<const T&> Reusable,
+          std::invocable Make>
+auto output_slot(mpk::mix::value::Value& out,
+                 Reusable&& reusable,
+                 Make&& make)
+    -> T&
+{
+    static const auto* type = mpk::mix::value::type_of<T>();
+    if (out.type() == type)
+    {
+        auto& value = out.as<T>();
+        if (reusable(std::as_const(value)))
+            return value;
+    }
+    out = std::forward<Make>(make)();
+    return out.as<T>();
+}
+
+} // namespace gc
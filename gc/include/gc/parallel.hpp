@@ -0,0 +1,108 @@
+/** @file
+ * @brief Data-parallel helpers for node computations.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include "gc/computation_node.hpp"
+
+#include "mpk/mix/func_ref/func_ref.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <stop_token>
+#include <utility>
+#include <vector>
+
+
+namespace common {
+class ThreadPool;
+} // namespace common
+
+namespace gc {
+
+// Returns the thread pool shared by all nodes of the process; it has
+// a thread for each hardware thread. Nodes should use it instead of
+// starting their own threads, so that cores are not oversubscribed.
+auto shared_thread_pool() -> common::ThreadPool&;
+
+// Returns the number of chunks `parallel_for` and `parallel_reduce`
+// split `n` elements into: there are at least `grain` elements in
+// a chunk, and there are a few chunks per pool thread.
+auto parallel_chunk_count(size_t n, size_t grain) -> size_t;
+
+using ParallelChunkBody =
+    mpk::mix::FuncRef<void(size_t ichunk, size_t begin, size_t end)>;
+
+// Calls `body` for each of `chunk_count` consecutive chunks of [0, n)
+// on the shared thread pool. The calling thread takes part in the work,
+// so the function may be called from a node computed on the pool.
+// Chunks not started before a stop is requested are skipped. `progress`,
+// if set, is called with the fraction of finished chunks, one call
+// at a time. Exceptions thrown by `body` are rethrown.
+// Returns false if a stop has been requested.
+auto parallel_chunks(size_t n,
+                     size_t chunk_count,
+                     const ParallelChunkBody& body,
+                     const std::stop_token& stoken,
+                     const NodeProgress& progress)
+    -> bool;
+
+// Calls `body(begin, end)` for subranges of [0, n) in parallel
+// (see `parallel_chunks`).
+template <std::invocable<size_t, size_t> Body>
+auto parallel_for(size_t n,
+                  Body&& body,
+                  const std::stop_token& stoken,
+                  const NodeProgress& progress = {},
+                  size_t grain = 1)
+    -> bool
+{
+    auto chunk_body = [&](size_t, size_t begin, size_t end)
+    { body(begin, end); };
+    return parallel_chunks(n,
+                           parallel_chunk_count(n, grain),
+                           ParallelChunkBody{ &chunk_body },
+                           stoken,
+                           progress);
+}
+
+// Computes `body(begin, end)` for subranges of [0, n) in parallel
+// (see `parallel_chunks`), and combines the results in the order
+// of subranges, starting with `identity`, using `reduce`. Returns nothing
+// if a stop has been requested.
+template <typename T,
+          std::invocable<size_t, size_t> Body,
+          std::invocable<T, T> Reduce>
+auto parallel_reduce(size_t n,
+                     T identity,
+                     Body&& body,
+                     Reduce&& reduce,
+                     const std::stop_token& stoken,
+                     const NodeProgress& progress = {},
+                     size_t grain = 1)
+    -> std::optional<T>
+{
+    auto chunk_count = parallel_chunk_count(n, grain);
+    auto partial = std::vector<std::optional<T>>(chunk_count);
+    auto chunk_body = [&](size_t ichunk, size_t begin, size_t end)
+    { partial[ichunk].emplace(body(begin, end)); };
+    if (!parallel_chunks(n,
+                         chunk_count,
+                         ParallelChunkBody{ &chunk_body },
+                         stoken,
+                         progress))
+        return std::nullopt;
+
+    auto result = std::move(identity);
+    for (auto& p : partial)
+        result = reduce(std::move(result), std::move(*p));
+    return result;
+}
+
+} // namespace gc
@@ -0,0 +1,87 @@
+/** @file
+ * @brief Computation of one graph for many combinations of source inputs.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include "gc/graph_computation.hpp"
+
+#include "mpk/mix/value/value.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <stop_token>
+#include <vector>
+
+
+namespace common {
+class ThreadPool;
+} // namespace common
+
+namespace gc {
+
+// Source input values that differ in one variant of a parameter sweep
+// from the values of `Computation::source_inputs`.
+struct SweepVariant final
+{
+    struct Input final
+    {
+        // Index in `SourceInputs::values`
+        size_t index;
+
+        mpk::mix::value::Value value;
+    };
+
+    std::vector<Input> inputs;
+};
+
+// Values taken by one source input in a parameter sweep
+struct SweepParameter final
+{
+    // Index in `SourceInputs::values`
+    size_t index;
+
+    mpk::mix::value::ValueVec values;
+};
+
+// Returns variants for all combinations of parameter values;
+// the value of the last parameter changes fastest.
+auto sweep_variants(std::span<const SweepParameter> parameters)
+    -> std::vector<SweepVariant>;
+
+// Called once for each computed variant, with the variant index
+// and the computation result. Calls are not concurrent but come
+// in the order in which variants are finished.
+using SweepResultHandler =
+    std::function<void(size_t ivariant, const ComputationResult& result)>;
+
+// Computes the graph of `c` for each variant and passes results to
+// `handle_result` as soon as they are ready.
+//
+// The first variant is computed in `c` itself, using the dataflow executor.
+// Each of the remaining variants is then computed by a task on `pool` in
+// a copy of the result of the first one, with `compute_dirty`, so nodes
+// not depending on the parameters of the sweep are computed only once.
+// Variants are computed concurrently; memory held by results is bounded
+// by the number of pool threads, because a result copy is released as soon
+// as it is handled.
+//
+// On return, `c` holds the result of the first variant, and its source
+// inputs have versions enabled and values of that variant. Only the first
+// variant is profiled, if `c.result.profile` is set.
+//
+// Returns false if the computation has been interrupted; in this case,
+// results of some variants are not handled.
+auto compute_sweep(Computation& c,
+                   std::span<const SweepVariant> variants,
+                   const SweepResultHandler& handle_result,
+                   const std::stop_token& stoken,
+                   common::ThreadPool& pool)
+    -> bool;
+
+} // namespace gc
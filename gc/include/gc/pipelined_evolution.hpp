@@ -0,0 +1,60 @@
+/** @file
+ * @brief Evolution executor overlapping consecutive steps.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include "gc/graph_computation.hpp"
+#include "gc/graph_evolution.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <stop_token>
+
+
+namespace gc {
+
+// Called after each evolution step with the step number, starting from 1,
+// and the result containing outputs of that step. Calls are made in the
+// order of steps, one at a time.
+using EvolutionStepHandler =
+    std::function<void(size_t step, const ComputationResult& result)>;
+
+// Evolves the computation `c`, which must already be computed, by `steps`
+// steps.
+//
+// Graph nodes are divided into loop nodes, i.e., ones on paths from feedback
+// sinks to feedback sources, and post-processing nodes, i.e., other nodes
+// depending on feedback sinks. Loop nodes are computed on the calling
+// thread, and post-processing nodes are computed on another thread,
+// so step t+1 of the loop overlaps with post-processing of step t.
+// Outputs of loop nodes consumed by post-processing nodes are passed between
+// threads in frames; at most `queue_capacity` frames are queued, so the loop
+// runs at most that many steps ahead of post-processing.
+//
+// The result passed to `handle_step` is that of post-processing; outputs of
+// loop nodes not consumed by post-processing nodes are not updated there,
+// unless they are listed in `handled_outputs`: these are passed in frames
+// too, so that `handle_step` can read them. On return, `c.result` contains outputs of all nodes at the last step,
+// as if the steps have been computed one after another.
+//
+// If there are no post-processing nodes, or a feedback sink is not a loop
+// node, steps are computed sequentially, and `handle_step` is passed
+// `c.result`.
+//
+// Returns false if the computation has been interrupted.
+auto evolve_pipelined(Computation& c,
+                      const GraphEvolution& evolution,
+                      size_t steps,
+                      size_t queue_capacity,
+                      const EvolutionStepHandler& handle_step,
+                      const std::stop_token& stoken,
+                      std::span<const EdgeOutputEnd> handled_outputs = {})
+    -> bool;
+
+} // namespace gc
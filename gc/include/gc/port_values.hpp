@@ -11,10 +11,15 @@
 #pragma once
 
 #include "gc/port.hpp"
-#include "mpk/mix/value/value_fwd.hpp"
+#include "mpk/mix/value/value.hpp"
 
 #include "mpk/mix/strong/span.hpp"
+#include "mpk/mix/util/index_range.hpp"
 
+#include <cassert>
+#include <concepts>
+#include <iterator>
+#include <ranges>
 #include <string_view>
 
 
@@ -32,7 +37,103 @@ using OutputValues =
 using InputValues =
     mpk::mix::StrongSpan<mpk::mix::value::Value, InputPort>;
 
-using ConstInputValues =
-    mpk::mix::StrongSpan<const mpk::mix::value::Value, InputPort>;
+// Read-only view of node input values. The values are either stored
+// contiguously, or referenced one by one - the engine uses the latter
+// to bind node inputs to upstream node outputs without copying them.
+class ConstInputValues final
+{
+public:
+    using Value = mpk::mix::value::Value;
+
+    class iterator final
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Value;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Value*;
+        using reference = const Value&;
+
+        iterator() = default;
+
+        iterator(const ConstInputValues* values, WeakPort index) noexcept :
+            values_{ values },
+            index_{ index }
+        {}
+
+        auto operator*() const -> reference
+        { return (*values_)[InputPort{index_}]; }
+
+        auto operator->() const -> pointer
+        { return &**this; }
+
+        auto operator++() -> iterator&
+        {
+            ++index_;
+            return *this;
+        }
+
+        auto operator++(int) -> iterator
+        {
+            auto result = *this;
+            ++index_;
+            return result;
+        }
+
+        auto operator==(const iterator&) const noexcept -> bool = default;
+
+    private:
+        const ConstInputValues* values_{};
+        WeakPort index_{};
+    };
+
+    ConstInputValues() = default;
+
+    ConstInputValues(const Value* values, InputPortCount size) noexcept :
+        values_{ values },
+        size_{ size }
+    {}
+
+    ConstInputValues(const Value* const* refs, InputPortCount size) noexcept :
+        refs_{ refs },
+        size_{ size }
+    {}
+
+    template <std::ranges::contiguous_range R>
+    requires std::same_as<std::ranges::range_value_t<R>, Value>
+    ConstInputValues(const R& values) noexcept :
+        values_{ std::ranges::data(values) },
+        size_{ static_cast<WeakPort>(std::ranges::distance(values)) }
+    {}
+
+    auto size() const noexcept -> InputPortCount
+    { return size_; }
+
+    auto empty() const noexcept -> bool
+    { return size_ == mpk::mix::Zero; }
+
+    auto index_range() const noexcept
+    { return mpk::mix::index_range<InputPort>(size_); }
+
+    auto operator[](InputPort port) const -> const Value&
+    {
+        assert(port < size_);
+        return refs_ ? *refs_[port.v] : values_[port.v];
+    }
+
+    auto front() const -> const Value&
+    { return (*this)[InputPort{0}]; }
+
+    auto begin() const noexcept -> iterator
+    { return { this, 0 }; }
+
+    auto end() const noexcept -> iterator
+    { return { this, size_.v }; }
+
+private:
+    const Value* values_{};
+    const Value* const* refs_{};
+    InputPortCount size_{};
+};
 
 } // namespace gc
@@ -0,0 +1,86 @@
+/** @file
+ * @brief Lock-free collection of node progress sampled at a fixed rate.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include "gc/graph_computation.hpp"
+#include "gc/node_index.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+
+namespace gc {
+
+// Collects progress of nodes without locks: each node has a slot of its own
+// written by the thread computing the node, so nodes computed in parallel
+// never wait for each other, nor for the receiver of progress. Collected
+// progress is passed on by `sample`, at the rate the receiver can afford.
+// Pass `GraphProgress{ &aggregator }` to `compute` to collect its progress.
+class ProgressAggregator final
+{
+public:
+    explicit ProgressAggregator(size_t node_count = 0);
+
+    // Forgets progress of all nodes. Must not be called concurrently
+    // with other methods.
+    auto reset(size_t node_count) -> void;
+
+    // Stores progress of node `inode`; may be called concurrently
+    // from different threads.
+    auto operator()(NodeIndex inode, double node_progress) noexcept -> void;
+
+    // Calls `progress` for each node whose progress has changed since
+    // the previous call, and returns the number of such nodes. Must not
+    // be called concurrently with itself.
+    auto sample(const GraphProgress& progress) -> size_t;
+
+private:
+    // Slots of different nodes are in different cache lines,
+    // so that threads computing them do not contend
+    static constexpr size_t cache_line_size = 64;
+
+    // Value of nodes that have not reported progress yet
+    static constexpr double not_reported = -1;
+
+    struct alignas(cache_line_size) Slot final
+    {
+        std::atomic<double> value{ not_reported };
+    };
+
+    std::vector<Slot> slots_;
+
+    // Values last passed on by `sample`
+    std::vector<double> sampled_;
+};
+
+// Passes progress collected by `aggregator` on to `progress` from a thread
+// of its own, every `period`, until destroyed. Changes made before
+// the destruction are passed on by the destructor.
+class ProgressReporter final
+{
+public:
+    ProgressReporter(ProgressAggregator& aggregator,
+                     const GraphProgress& progress,
+                     std::chrono::milliseconds period);
+
+    ~ProgressReporter();
+
+    ProgressReporter(const ProgressReporter&) = delete;
+    auto operator=(const ProgressReporter&) -> ProgressReporter& = delete;
+
+private:
+    ProgressAggregator& aggregator_;
+    GraphProgress progress_;
+    std::jthread thread_;
+};
+
+} // namespace gc
@@ -0,0 +1,86 @@
+/** @file
+ * @brief Memoizing cache of node computation results.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include "gc/computation_node_fwd.hpp"
+#include "gc/port_values.hpp"
+#include "gc/value_fingerprint.hpp"
+
+#include <functional>
+#include <memory>
+
+
+namespace gc {
+
+// Stores node outputs keyed by the node and the values of its inputs,
+// so that computing a node with a combination of inputs seen before
+// reduces to copying the outputs. Since a node object is created from its
+// type and init args, the node stands for both in the key.
+//
+// The cache is bounded by the total size of input and output values stored
+// in it; least recently used entries are evicted first. Value sizes are
+// estimated by the function passed to the constructor; by default, each value
+// has the size `sizeof(Value)`.
+//
+// Entries are looked up by a hash of the node and its input values, computed
+// by the fingerprint function passed to the constructor; input values are
+// compared only for entries with the same hash. Values the function cannot
+// hash (and all values, if there is no function) contribute only their
+// types to the hash.
+//
+// Nodes whose `ComputationNode::cacheable` returns false are never
+// memoized, and the cache is not consulted for nodes recomputed on purpose,
+// i.e., outdated ones or ones having inputs updated manually.
+//
+// The cache is thread safe.
+class ResultCache final
+{
+public:
+    using ValueSize = std::function<size_t(const mpk::mix::value::Value&)>;
+
+    explicit ResultCache(size_t capacity,
+                         ValueSize value_size = {},
+                         ValueFingerprint fingerprint = {});
+
+    ~ResultCache();
+
+    ResultCache(const ResultCache&) = delete;
+    auto operator=(const ResultCache&) -> ResultCache& = delete;
+
+    // Copies cached outputs of `node` computed for `inputs` to `outputs`;
+    // returns false if there are no such outputs in the cache.
+    auto find(const ComputationNode* node,
+              ConstInputValues inputs,
+              OutputValues outputs)
+        -> bool;
+
+    // Stores `outputs` computed by `node` for `inputs`. Entries larger
+    // than the capacity are not stored.
+    auto insert(const ComputationNodePtr& node,
+                ConstInputValues inputs,
+                OutputValues outputs)
+        -> void;
+
+    auto clear() -> void;
+
+    auto capacity() const noexcept -> size_t;
+
+    // Total size of values currently stored in the cache
+    auto size() const -> size_t;
+
+    auto hit_count() const -> size_t;
+
+    auto miss_count() const -> size_t;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace gc
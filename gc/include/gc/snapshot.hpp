@@ -0,0 +1,270 @@
+/** @file
+ * @brief Binary snapshots of computation state.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include "gc/graph_computation.hpp"
+
+#include "mpk/mix/util/throw.hpp"
+#include "mpk/mix/value/type.hpp"
+#include "mpk/mix/value/value.hpp"
+
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+
+namespace gc {
+
+// Codecs of values stored in snapshots. A value is encoded as a small
+// header (e.g., image size) and a payload, the bytes of its bulk data
+// (e.g., pixels). Payloads are written as they are, with no intermediate
+// copies, at page-aligned file offsets, so that a snapshot file can be
+// memory-mapped, and each payload decoded by a single copy from
+// the mapped pages.
+//
+// The default constructor registers codecs for arithmetic types, vectors
+// of them, and strings.
+class SnapshotCodecs final
+{
+public:
+    using Value = mpk::mix::value::Value;
+    using Bytes = std::span<const std::byte>;
+
+    struct Codec final
+    {
+        // Identifies the encoding in snapshot files
+        std::string name;
+
+        const mpk::mix::value::Type* type;
+
+        // Appends the header of the value to `header` and returns
+        // its payload, which must be part of the value
+        std::function<Bytes(const Value& value, std::string& header)> encode;
+
+        std::function<Value(Bytes header, Bytes payload)> decode;
+    };
+
+    SnapshotCodecs();
+
+    auto add_codec(Codec codec) -> void;
+
+    // Both return null if there is no such codec
+    auto find(const mpk::mix::value::Type* type) const -> const Codec*;
+    auto find(std::string_view name) const -> const Codec*;
+
+    // Returns a codec storing the bytes of a value of a trivially copyable
+    // type `T` in the header, or the elements of a vector of such values
+    // in the payload. Decoding throws `std::invalid_argument` if the size
+    // of the header or the payload does not fit the type.
+    template <typename T>
+    static auto trivial_codec(std::string name) -> Codec;
+
+private:
+    std::vector<Codec> codecs_;
+    std::unordered_map<std::string, size_t> codec_by_name_;
+    std::unordered_map<const mpk::mix::value::Type*, size_t> codec_by_type_;
+};
+
+// Thrown by `restore_snapshot` if the snapshot is one of another graph
+class SnapshotMismatch final :
+    public std::invalid_argument
+{
+public:
+    using std::invalid_argument::invalid_argument;
+};
+
+// State of a computation detached from it, so that it can be saved
+// while the computation goes on (see `SnapshotWriter`). Only the parts
+// of `result` listed by `take_snapshot` are set.
+struct ComputationSnapshot final
+{
+    ComputationGraph graph;
+    mpk::mix::value::ValueVec source_inputs;
+    ComputationResult result;
+    uint64_t evolution_step{};
+    std::string graph_id;
+};
+
+// Copies the state of a computation: source inputs, node inputs and
+// outputs, node timestamps (`node_ts`, `changed_ts`), output fingerprints,
+// and `computation_ts`. See `save_snapshot` for `graph_id`.
+auto take_snapshot(const ComputationGraph& g,
+                   const SourceInputs& source_inputs,
+                   const ComputationResult& result,
+                   uint64_t evolution_step,
+                   std::string_view graph_id = {})
+    -> ComputationSnapshot;
+
+inline auto take_snapshot(const Computation& c,
+                          uint64_t evolution_step,
+                          std::string_view graph_id = {})
+    -> ComputationSnapshot
+{
+    return take_snapshot(
+        c.graph, c.source_inputs, c.result, evolution_step, graph_id);
+}
+
+// Writes the state of a computation to the file `path`. The file is
+// replaced atomically, so a crash while saving leaves the previous snapshot
+// intact. Values of types having no codec are not saved; nodes having such
+// inputs or outputs are saved as outdated, so they are recomputed after
+// restoring the snapshot.
+//
+// Along with the state, a signature of the graph (C++ types and port names
+// of nodes) and `graph_id` are saved; the latter identifies the definition
+// of the graph, e.g., it is the text of the definition, and tells apart
+// graphs having the same nodes with different parameters.
+auto save_snapshot(const std::filesystem::path& path,
+                   const ComputationGraph& g,
+                   const SourceInputs& source_inputs,
+                   const ComputationResult& result,
+                   uint64_t evolution_step,
+                   const SnapshotCodecs& codecs,
+                   std::string_view graph_id = {})
+    -> void;
+
+inline auto save_snapshot(const std::filesystem::path& path,
+                          const Computation& c,
+                          uint64_t evolution_step,
+                          const SnapshotCodecs& codecs,
+                          std::string_view graph_id = {})
+    -> void
+{
+    save_snapshot(path, c.graph, c.source_inputs, c.result,
+                  evolution_step, codecs, graph_id);
+}
+
+auto save_snapshot(const std::filesystem::path& path,
+                   const ComputationSnapshot& snapshot,
+                   const SnapshotCodecs& codecs)
+    -> void;
+
+// Restores the state of computation `c` saved by `save_snapshot`, and
+// returns the evolution step of the snapshot. The graph of `c` must have
+// the same signature and `graph_id` as the saved one, and source inputs
+// of the same types; otherwise, `SnapshotMismatch` is thrown. A file that
+// is not a valid snapshot causes `std::invalid_argument`. Results of nodes
+// are restored like by `adopt_result`: nodes whose incoming edges differ
+// from the saved ones, and nodes downstream of them, remain outdated.
+// Source inputs having no saved value keep their values.
+auto restore_snapshot(Computation& c,
+                      const std::filesystem::path& path,
+                      const SnapshotCodecs& codecs,
+                      std::string_view graph_id = {})
+    -> uint64_t;
+
+// Saves snapshots passed to `save` to a file, on a thread of its own,
+// so a computation is only paused to take a snapshot, not to write it.
+// If snapshots are passed faster than they are written, pending ones
+// are replaced by newer ones. A pending snapshot is written before
+// the writer is destroyed.
+class SnapshotWriter final
+{
+public:
+    SnapshotWriter(std::filesystem::path path, SnapshotCodecs codecs);
+
+    ~SnapshotWriter();
+
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    auto operator=(const SnapshotWriter&) -> SnapshotWriter& = delete;
+
+    auto save(ComputationSnapshot snapshot) -> void;
+
+    // Waits until snapshots passed to `save` have been written
+    auto flush() -> void;
+
+    auto path() const noexcept -> const std::filesystem::path&;
+
+    // Number of snapshots written
+    auto saved_count() const -> size_t;
+
+    // Message of the last failure to write a snapshot, or an empty string
+    // if the last snapshot has been written
+    auto error() const -> std::string;
+
+private:
+    std::filesystem::path path_;
+    SnapshotCodecs codecs_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable_any wakeup_;
+    std::optional<ComputationSnapshot> pending_;
+    bool writing_{};
+    size_t saved_count_{};
+    std::string error_;
+
+    std::jthread thread_;
+};
+
+
+template <typename T>
+auto SnapshotCodecs::trivial_codec(std::string name) -> Codec
+{
+    if constexpr (requires { typename T::value_type; })
+    {
+        using E = typename T::value_type;
+        static_assert(std::same_as<T, std::vector<E>>);
+        static_assert(std::is_trivially_copyable_v<E>);
+        return {
+            .name = std::move(name),
+            .type = mpk::mix::value::type_of<T>(),
+            .encode = [](const Value& value, std::string&) -> Bytes
+            { return std::as_bytes(std::span{ value.as<T>() }); },
+            .decode = [](Bytes, Bytes payload) -> Value
+            {
+                if (payload.size() % sizeof(E) != 0)
+                    mpk::mix::throw_<std::invalid_argument>(
+                        "Payload size {} is not a multiple of element size {}",
+                        payload.size(), sizeof(E));
+                auto v = T(payload.size() / sizeof(E));
+                std::memcpy(v.data(), payload.data(), v.size() * sizeof(E));
+                return v;
+            } };
+    }
+    else
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        return {
+            .name = std::move(name),
+            .type = mpk::mix::value::type_of<T>(),
+            .encode = [](const Value& value, std::string& header) -> Bytes
+            {
+                header.append(
+                    reinterpret_cast<const char*>(&value.as<T>()),
+                    sizeof(T));
+                return {};
+            },
+            .decode = [](Bytes header, Bytes) -> Value
+            {
+                if (header.size() != sizeof(T))
+                    mpk::mix::throw_<std::invalid_argument>(
+                        "Header size {} does not match value size {}",
+                        header.size(), sizeof(T));
+                auto v = T{};
+                std::memcpy(&v, header.data(), sizeof(T));
+                return v;
+            } };
+    }
+}
+
+} // namespace gc
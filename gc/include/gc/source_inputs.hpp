@@ -15,19 +15,40 @@
 
 #include "mpk/mix/strong/grouped.hpp"
 
+#include <cstdint>
 #include <ostream>
+#include <vector>
 
 
 namespace gc {
 
+using SourceInputVersion = uint64_t;
+
 struct SourceInputs final
 {
     mpk::mix::value::ValueVec values;
     mpk::mix::Grouped<EdgeInputEnd> destinations;
 
+    // Either empty or contains a version stamp for each element of `values`.
+    // If present, computations detect changes of source inputs by comparing
+    // version stamps rather than values, so any modification of a value must
+    // be followed by a call to `touch`.
+    std::vector<SourceInputVersion> versions;
+
     auto operator==(const SourceInputs&) const noexcept -> bool = default;
 };
 
+// Returns a version stamp different from all stamps returned before.
+// Stamps are never zero.
+auto new_source_input_version() noexcept -> SourceInputVersion;
+
+// Assigns version stamps to all source inputs, unless already done.
+auto enable_versions(SourceInputs& source_inputs) -> void;
+
+// Updates version stamp of the specified source input after its value has
+// been modified. Does nothing if versions are not enabled.
+auto touch(SourceInputs& source_inputs, size_t index) -> void;
+
 auto operator<<(std::ostream& s, const SourceInputs& source_inputs)
     -> std::ostream&;
 
@@ -0,0 +1,77 @@
+/** @file
+ * @brief Cheap hashes of values used to detect unchanged node outputs.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include "mpk/mix/value/value_fwd.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <type_traits>
+
+
+namespace gc {
+
+// Returns a hash of the value, or zero if values of its type
+// cannot be hashed (see `ComputationResult::fingerprint`).
+using ValueFingerprint =
+    std::function<uint64_t(const mpk::mix::value::Value& value)>;
+
+// Accumulates a 64-bit hash of data passed to it. Not cryptographic:
+// it only has to tell apart consecutive outputs of a node.
+class Fingerprint final
+{
+public:
+    auto add_bytes(const void* data, size_t size) noexcept -> Fingerprint&
+    {
+        const auto* bytes = static_cast<const std::byte*>(data);
+        mix(size);
+        for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t))
+        {
+            auto word = uint64_t{};
+            std::memcpy(&word, bytes, sizeof(word));
+            mix(word);
+            bytes += sizeof(word);
+        }
+        if (size > 0)
+        {
+            auto word = uint64_t{};
+            std::memcpy(&word, bytes, size);
+            mix(word);
+        }
+        return *this;
+    }
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    auto add(const T& value) noexcept -> Fingerprint&
+    { return add_bytes(&value, sizeof(T)); }
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    auto add_values(std::span<const T> values) noexcept -> Fingerprint&
+    { return add_bytes(values.data(), values.size_bytes()); }
+
+    // Never zero
+    auto value() const noexcept -> uint64_t
+    { return hash_ == 0 ? 1 : hash_; }
+
+private:
+    uint64_t hash_{ 0xcbf29ce484222325 };
+
+    auto mix(uint64_t word) noexcept -> void
+    {
+        hash_ = (hash_ ^ word) * 0x9e3779b97f4a7c15;
+        hash_ ^= hash_ >> 32;
+    }
+};
+
+} // namespace gc
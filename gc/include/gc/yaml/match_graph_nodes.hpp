@@ -0,0 +1,30 @@
+/** @file
+ * @brief Matching of nodes of two versions of a graph file.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include "gc/node_index.hpp"
+
+#include <yaml-cpp/node/node.h>
+
+#include <optional>
+#include <vector>
+
+
+namespace gc::yaml {
+
+// Returns, for each node of the `graph` section `config`, the index of
+// the node of the previous version `prev_config` having the same name,
+// type, and initializers, if any. The result is suitable for
+// `adopt_result`, since `parse_graph` creates nodes in the order of
+// their declaration.
+auto match_graph_nodes(const YAML::Node& config,
+                       const YAML::Node& prev_config)
+    -> std::vector<std::optional<NodeIndex>>;
+
+} // namespace gc::yaml
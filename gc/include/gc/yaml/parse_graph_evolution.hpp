@@ -0,0 +1,31 @@
+/** @file
+ * @brief Parsing of the `evolution` section of a graph file.
+ *
+ * Copyright (C) 2025-2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include "gc/computation_graph.hpp"
+#include "gc/detail/named_nodes.hpp"
+#include "gc/graph_evolution.hpp"
+
+#include <yaml-cpp/node/node.h>
+
+
+namespace gc::yaml {
+
+// Parses feedback edges, e.g.,
+//   feedback:
+//     - source: cell2d.output_state
+//       sink: [cell2d.input_state]
+// Feedback buffers are swapped where possible (see `make_evolution_feedback`).
+auto parse_graph_evolution(
+    const YAML::Node& config,
+    const ComputationGraph& graph,
+    const detail::NamedNodes<ComputationNode>& node_map)
+    -> GraphEvolution;
+
+} // namespace gc::yaml
@@ -0,0 +1,196 @@
+/** @file
+ * @brief Work-stealing thread pool.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "common/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace common {
+
+class ThreadPool::Impl final
+{
+public:
+    explicit Impl(size_t thread_count) :
+        queues_(std::max<size_t>(thread_count, 1))
+    {
+        threads_.reserve(queues_.size());
+        for (size_t i=0, n=queues_.size(); i<n; ++i)
+            threads_.emplace_back([this, i]{ worker(i); });
+    }
+
+    ~Impl()
+    {
+        {
+            auto lock = std::lock_guard{ mutex_ };
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto& t : threads_)
+            t.join();
+    }
+
+    auto thread_count() const noexcept -> size_t
+    { return threads_.size(); }
+
+    auto submit(Task task) -> void
+    {
+        auto iqueue =
+            current_pool_ == this
+                ? current_worker_
+                : next_queue_.fetch_add(1, std::memory_order_relaxed)
+                    % queues_.size();
+        {
+            auto& q = queues_[iqueue];
+            auto lock = std::lock_guard{ q.mutex };
+            q.tasks.push_back(std::move(task));
+        }
+        queued_.fetch_add(1, std::memory_order_release);
+        {
+            auto lock = std::lock_guard{ mutex_ };
+        }
+        cv_.notify_one();
+    }
+
+    auto run_until(const std::function<bool()>& done) -> void
+    {
+        auto iqueue = current_pool_ == this ? current_worker_ : size_t{};
+        ++waiters_;
+        while (!done())
+        {
+            auto task = Task{};
+            if (pop(iqueue, task) || steal(iqueue, task))
+            {
+                run(task);
+                continue;
+            }
+
+            auto lock = std::unique_lock{ mutex_ };
+            done_cv_.wait(lock, [&]{
+                return done() ||
+                       queued_.load(std::memory_order_acquire) > 0; });
+        }
+        --waiters_;
+    }
+
+private:
+    struct Queue final
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<Queue> queues_;
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::condition_variable done_cv_;
+    bool stop_{};
+
+    std::atomic<size_t> queued_{};
+    std::atomic<size_t> next_queue_{};
+    std::atomic<size_t> waiters_{};
+
+    static thread_local Impl* current_pool_;
+    static thread_local size_t current_worker_;
+
+    auto worker(size_t i) -> void
+    {
+        current_pool_ = this;
+        current_worker_ = i;
+
+        while (true)
+        {
+            auto task = Task{};
+            if (pop(i, task) || steal(i, task))
+            {
+                run(task);
+                continue;
+            }
+
+            auto lock = std::unique_lock{ mutex_ };
+            cv_.wait(lock, [&]{
+                return stop_ || queued_.load(std::memory_order_acquire) > 0; });
+            if (stop_ && queued_.load(std::memory_order_acquire) == 0)
+                return;
+        }
+    }
+
+    // Takes the most recently pushed task from the own queue
+    auto pop(size_t i, Task& task) -> bool
+    {
+        auto& q = queues_[i];
+        auto lock = std::lock_guard{ q.mutex };
+        if (q.tasks.empty())
+            return false;
+        task = std::move(q.tasks.back());
+        q.tasks.pop_back();
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Takes the oldest task from a queue owned by another worker
+    auto steal(size_t i, Task& task) -> bool
+    {
+        for (size_t d=1, n=queues_.size(); d<n; ++d)
+        {
+            auto& q = queues_[(i + d) % n];
+            auto lock = std::lock_guard{ q.mutex };
+            if (q.tasks.empty())
+                continue;
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    auto run(Task& task) -> void
+    {
+        task();
+        if (waiters_.load(std::memory_order_acquire) > 0)
+        {
+            {
+                auto lock = std::lock_guard{ mutex_ };
+            }
+            done_cv_.notify_all();
+        }
+    }
+};
+
+thread_local ThreadPool::Impl* ThreadPool::Impl::current_pool_{};
+thread_local size_t ThreadPool::Impl::current_worker_{};
+
+
+ThreadPool::ThreadPool(size_t thread_count) :
+    impl_{ std::make_unique<Impl>(
+        thread_count == 0 ? std::thread::hardware_concurrency()
+                          : thread_count) }
+{}
+
+ThreadPool::~ThreadPool() = default;
+
+auto ThreadPool::thread_count() const noexcept -> size_t
+{ return impl_->thread_count(); }
+
+auto ThreadPool::submit(Task task) -> void
+{ impl_->submit(std::move(task)); }
+
+auto ThreadPool::run_until(const std::function<bool()>& done) -> void
+{ impl_->run_until(done); }
+
+} // namespace common
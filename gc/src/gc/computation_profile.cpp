@@ -0,0 +1,121 @@
+/** @file
+ * @brief Per-node profiling of graph computations.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "gc/computation_profile.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <format>
+#include <vector>
+
+
+namespace gc {
+
+namespace {
+
+auto ms(std::chrono::nanoseconds t) -> double
+{ return t.count() / 1e6; }
+
+auto time_share(std::chrono::nanoseconds t, std::chrono::nanoseconds total)
+    -> double
+{ return total.count() > 0 ? double(t.count()) / total.count() : 0.; }
+
+auto write_json_string(std::ostream& s, std::string_view str)
+    -> void
+{
+    s << '"';
+    for (auto c : str)
+    {
+        if (c == '"' || c == '\\')
+            s << '\\' << c;
+        else if (static_cast<unsigned char>(c) < 0x20)
+            s << std::format("\\u{:04x}", int(c));
+        else
+            s << c;
+    }
+    s << '"';
+}
+
+} // anonymous namespace
+
+auto ComputationProfile::total_time() const noexcept
+    -> std::chrono::nanoseconds
+{
+    auto result = std::chrono::nanoseconds{};
+    for (const auto& node : nodes)
+        result += node.time;
+    return result;
+}
+
+auto print_profile_table(std::ostream& s,
+                         const ComputationProfile& profile,
+                         NodeLabels node_labels)
+    -> void
+{
+    assert(node_labels.size() == profile.nodes.size());
+
+    auto order = std::vector<NodeIndex>{};
+    for (auto inode : profile.nodes.index_range())
+        order.push_back(inode);
+    std::ranges::stable_sort(
+        order, std::greater{},
+        [&](NodeIndex inode){ return profile.nodes[inode].time; });
+
+    auto label_width = size_t{4};
+    for (auto label : node_labels)
+        label_width = std::max(label_width, label.size());
+
+    auto total = profile.total_time();
+
+    s << std::format("{:<{}}  {:>8}  {:>8}  {:>8}  {:>12}  {:>7}  {:>14}\n",
+                     "node", label_width,
+                     "calls", "skips", "cutoffs", "time, ms", "share",
+                     "edge bytes");
+    for (auto inode : order)
+    {
+        const auto& node = profile.nodes[inode];
+        s << std::format(
+            "{:<{}}  {:>8}  {:>8}  {:>8}  {:>12.3f}  {:>6.1f}%  {:>14}\n",
+            node_labels[inode], label_width,
+            node.call_count, node.skip_count, node.cutoff_count,
+            ms(node.time), 100 * time_share(node.time, total),
+            node.edge_bytes);
+    }
+    s << std::format("{:<{}}  {:>8}  {:>8}  {:>8}  {:>12.3f}\n",
+                     "total", label_width, "", "", "", ms(total));
+}
+
+auto print_profile_json(std::ostream& s,
+                        const ComputationProfile& profile,
+                        NodeLabels node_labels)
+    -> void
+{
+    assert(node_labels.size() == profile.nodes.size());
+
+    auto total = profile.total_time();
+
+    s << "{\n  \"total_time_ms\": " << ms(total) << ",\n  \"nodes\": [";
+    auto delim = "\n";
+    for (auto inode : profile.nodes.index_range())
+    {
+        const auto& node = profile.nodes[inode];
+        s << delim << "    {\"index\": " << inode.v << ", \"label\": ";
+        write_json_string(s, node_labels[inode]);
+        s << ", \"calls\": " << node.call_count
+          << ", \"skips\": " << node.skip_count
+          << ", \"cutoffs\": " << node.cutoff_count
+          << ", \"time_ms\": " << ms(node.time)
+          << ", \"time_share\": " << time_share(node.time, total)
+          << ", \"edge_bytes\": " << node.edge_bytes
+          << "}";
+        delim = ",\n";
+    }
+    s << "\n  ]\n}\n";
+}
+
+} // namespace gc
@@ -0,0 +1,420 @@
+/** @file
+ * @brief Persistent content-addressed cache of node computation results.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "gc/disk_cache.hpp"
+
+#include "gc/detail/binary_file.hpp"
+
+#include "mpk/mix/util/throw.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include <unistd.h>
+
+
+using namespace std::string_view_literals;
+
+namespace gc {
+
+namespace fs = std::filesystem;
+
+using detail::write_u64;
+using detail::write_block;
+
+namespace {
+
+// Cache file layout. All numbers are 64-bit in the native byte order,
+// and all blocks are padded to 8 bytes.
+//   magic, format version
+//   key: size, bytes
+//   output count
+//   for each output:
+//     codec name: size, bytes
+//     encoded value: size, bytes
+constexpr uint64_t file_magic = 0x67636469736b6361;
+constexpr uint64_t file_format_version = 1;
+constexpr auto file_extension = ".gcc"sv;
+
+auto fnv1a(std::string_view s) noexcept
+    -> uint64_t
+{
+    auto result = uint64_t{ 14695981039346656037ull };
+    for (auto c : s)
+    {
+        result ^= static_cast<unsigned char>(c);
+        result *= 1099511628211ull;
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+
+class DiskCache::Impl final
+{
+public:
+    Impl(fs::path dir, uint64_t capacity) :
+        dir_{ std::move(dir) },
+        capacity_{ capacity }
+    {
+        fs::create_directories(dir_);
+
+        for (const auto& item : fs::directory_iterator{ dir_ })
+        {
+            if (!item.is_regular_file() ||
+                item.path().extension() != file_extension)
+                continue;
+            auto size = item.file_size();
+            files_[item.path().filename().string()] =
+                { size, item.last_write_time(), 0 };
+            size_ += size;
+        }
+        evict();
+
+        add_codec(trivial_codec<int8_t>("i8"));
+        add_codec(trivial_codec<uint8_t>("u8"));
+        add_codec(trivial_codec<int16_t>("i16"));
+        add_codec(trivial_codec<uint16_t>("u16"));
+        add_codec(trivial_codec<int32_t>("i32"));
+        add_codec(trivial_codec<uint32_t>("u32"));
+        add_codec(trivial_codec<int64_t>("i64"));
+        add_codec(trivial_codec<uint64_t>("u64"));
+        add_codec(trivial_codec<float>("f32"));
+        add_codec(trivial_codec<double>("f64"));
+        add_codec(trivial_codec<std::vector<int8_t>>("i8[]"));
+        add_codec(trivial_codec<std::vector<uint8_t>>("u8[]"));
+        add_codec(trivial_codec<std::vector<int16_t>>("i16[]"));
+        add_codec(trivial_codec<std::vector<uint16_t>>("u16[]"));
+        add_codec(trivial_codec<std::vector<int32_t>>("i32[]"));
+        add_codec(trivial_codec<std::vector<uint32_t>>("u32[]"));
+        add_codec(trivial_codec<std::vector<int64_t>>("i64[]"));
+        add_codec(trivial_codec<std::vector<uint64_t>>("u64[]"));
+        add_codec(trivial_codec<std::vector<float>>("f32[]"));
+        add_codec(trivial_codec<std::vector<double>>("f64[]"));
+        add_codec({
+            .name = "str",
+            .type = mpk::mix::value::type_of<std::string>(),
+            .encode = [](const Value& value, std::string& bytes)
+            { bytes.append(value.as<std::string>()); },
+            .decode = [](Bytes bytes) -> Value
+            {
+                return std::string(
+                    reinterpret_cast<const char*>(bytes.data()),
+                    bytes.size());
+            } });
+    }
+
+    auto add_codec(Codec codec) -> void
+    {
+        auto lock = std::lock_guard{ mutex_ };
+
+        if (codec_by_name_.contains(codec.name))
+            mpk::mix::throw_<std::invalid_argument>(
+                "DiskCache: codec '{}' is already registered", codec.name);
+
+        auto index = codecs_.size();
+        codec_by_name_[codec.name] = index;
+        codec_by_type_[codec.type] = index;
+        codecs_.push_back(std::move(codec));
+    }
+
+    auto find(std::string_view node_id,
+              ConstInputValues inputs,
+              OutputValues outputs)
+        -> bool
+    {
+        auto lock = std::lock_guard{ mutex_ };
+
+        auto key = std::string{};
+        if (!encode_key(key, node_id, inputs))
+            return miss();
+
+        auto name = file_name(key);
+        auto it = files_.find(name);
+        if (it == files_.end())
+            return miss();
+
+        auto path = dir_ / name;
+        auto values = mpk::mix::value::ValueVec{};
+        {
+            auto file = detail::MappedFile{ path };
+            if (!file || !decode_file(values, file.bytes(), key, outputs))
+            {
+                // The file is corrupt or belongs to a colliding key
+                remove_file(it);
+                return miss();
+            }
+        }
+
+        std::ranges::move(values, outputs.begin());
+
+        auto now = fs::file_time_type::clock::now();
+        it->second.time = now;
+        it->second.use_index = ++use_count_;
+        auto ec = std::error_code{};
+        fs::last_write_time(path, now, ec);
+
+        ++hit_count_;
+        return true;
+    }
+
+    // Failures to write the file are ignored: the cache is an optimization,
+    // and the outputs have already been computed. Values are encoded and
+    // written without the lock held, so other threads are not held up.
+    auto insert(std::string_view node_id,
+                ConstInputValues inputs,
+                OutputValues outputs)
+        -> void
+    {
+        auto key = std::string{};
+        if (!encode_key(key, node_id, inputs))
+            return;
+
+        auto bytes = std::string{};
+        write_u64(bytes, file_magic);
+        write_u64(bytes, file_format_version);
+        write_block(bytes, key);
+        write_u64(bytes, outputs.size().v);
+        auto encoded = std::string{};
+        for (const auto& output : outputs)
+        {
+            const auto* codec = find_codec(output);
+            if (!codec)
+                return;
+            write_block(bytes, codec->name);
+            encoded.clear();
+            codec->encode(output, encoded);
+            write_block(bytes, encoded);
+        }
+
+        if (bytes.size() > capacity_)
+            return;
+
+        // Write a temporary file first, so that other processes never see
+        // a partially written cache file. Temporary file names are unique
+        // within the process, since threads may write the same entry.
+        auto name = file_name(key);
+        auto path = dir_ / name;
+        auto tmp_path = dir_ / std::format(
+            "{}.{}.{}.tmp", name, ::getpid(),
+            tmp_count_.fetch_add(1, std::memory_order_relaxed));
+        auto ec = std::error_code{};
+        {
+            auto s = std::ofstream(tmp_path, std::ios::binary);
+            s.write(bytes.data(), bytes.size());
+            s.close();
+            if (!s)
+            {
+                fs::remove(tmp_path, ec);
+                return;
+            }
+        }
+        fs::rename(tmp_path, path, ec);
+        if (ec)
+        {
+            fs::remove(tmp_path, ec);
+            return;
+        }
+        auto time = fs::last_write_time(path, ec);
+        if (ec)
+            time = fs::file_time_type::clock::now();
+
+        auto lock = std::lock_guard{ mutex_ };
+        if (auto it = files_.find(name); it != files_.end())
+            size_ -= it->second.size;
+        files_[name] = { bytes.size(), time, ++use_count_ };
+        size_ += bytes.size();
+        evict();
+    }
+
+    auto dir() const noexcept -> const fs::path&
+    { return dir_; }
+
+    auto capacity() const noexcept -> uint64_t
+    { return capacity_; }
+
+    auto size() const -> uint64_t
+    {
+        auto lock = std::lock_guard{ mutex_ };
+        return size_;
+    }
+
+    auto hit_count() const -> size_t
+    {
+        auto lock = std::lock_guard{ mutex_ };
+        return hit_count_;
+    }
+
+    auto miss_count() const -> size_t
+    {
+        auto lock = std::lock_guard{ mutex_ };
+        return miss_count_;
+    }
+
+private:
+    struct FileInfo final
+    {
+        uint64_t size;
+        fs::file_time_type time;
+
+        // Orders files used within the same file time tick
+        uint64_t use_index{};
+    };
+
+    using FileMap = std::unordered_map<std::string, FileInfo>;
+
+    fs::path dir_;
+    uint64_t capacity_;
+
+    mutable std::mutex mutex_;
+
+    // Read without the lock by `insert`, so codecs are added before
+    // the cache is used concurrently
+    std::vector<Codec> codecs_;
+    std::unordered_map<std::string, size_t> codec_by_name_;
+    std::unordered_map<const mpk::mix::value::Type*, size_t> codec_by_type_;
+
+    FileMap files_;
+    uint64_t size_{};
+    uint64_t use_count_{};
+    std::atomic<uint64_t> tmp_count_{};
+    size_t hit_count_{};
+    size_t miss_count_{};
+
+    auto miss() -> bool
+    {
+        ++miss_count_;
+        return false;
+    }
+
+    auto find_codec(const Value& value) const -> const Codec*
+    {
+        auto it = codec_by_type_.find(value.type());
+        return it == codec_by_type_.end() ? nullptr : &codecs_[it->second];
+    }
+
+    auto encode_key(std::string& key,
+                    std::string_view node_id,
+                    ConstInputValues inputs) const
+        -> bool
+    {
+        write_block(key, node_id);
+        auto encoded = std::string{};
+        for (const auto& input : inputs)
+        {
+            const auto* codec = find_codec(input);
+            if (!codec)
+                return false;
+            write_block(key, codec->name);
+            encoded.clear();
+            codec->encode(input, encoded);
+            write_block(key, encoded);
+        }
+        return true;
+    }
+
+    static auto file_name(std::string_view key)
+        -> std::string
+    { return std::format("{:016x}{}", fnv1a(key), file_extension); }
+
+    auto decode_file(mpk::mix::value::ValueVec& values,
+                     Bytes bytes,
+                     std::string_view key,
+                     OutputValues outputs) const
+        -> bool
+    {
+        auto r = detail::FileReader{ bytes };
+        if (r.u64() != file_magic ||
+            r.u64() != file_format_version ||
+            r.str() != key ||
+            r.u64() != outputs.size().v ||
+            !r)
+            return false;
+
+        for ([[maybe_unused]] auto port : outputs.index_range())
+        {
+            auto codec_name = r.str();
+            auto encoded = r.block();
+            if (!r)
+                return false;
+            auto it = codec_by_name_.find(std::string{ codec_name });
+            if (it == codec_by_name_.end())
+                return false;
+            values.push_back(codecs_[it->second].decode(encoded));
+        }
+        return true;
+    }
+
+    auto remove_file(FileMap::iterator it) -> void
+    {
+        auto ec = std::error_code{};
+        fs::remove(dir_ / it->first, ec);
+        size_ -= it->second.size;
+        files_.erase(it);
+    }
+
+    auto evict() -> void
+    {
+        while (size_ > capacity_)
+        {
+            assert(!files_.empty());
+            auto it = std::ranges::min_element(
+                files_, {},
+                [](const auto& item)
+                { return std::pair{ item.second.time, item.second.use_index }; });
+            remove_file(it);
+        }
+    }
+};
+
+
+DiskCache::DiskCache(fs::path dir, uint64_t capacity) :
+    impl_{ std::make_unique<Impl>(std::move(dir), capacity) }
+{}
+
+DiskCache::~DiskCache() = default;
+
+auto DiskCache::add_codec(Codec codec) -> void
+{ impl_->add_codec(std::move(codec)); }
+
+auto DiskCache::find(std::string_view node_id,
+                     ConstInputValues inputs,
+                     OutputValues outputs)
+    -> bool
+{ return impl_->find(node_id, inputs, outputs); }
+
+auto DiskCache::insert(std::string_view node_id,
+                       ConstInputValues inputs,
+                       OutputValues outputs)
+    -> void
+{ impl_->insert(node_id, inputs, outputs); }
+
+auto DiskCache::dir() const noexcept -> const fs::path&
+{ return impl_->dir(); }
+
+auto DiskCache::capacity() const noexcept -> uint64_t
+{ return impl_->capacity(); }
+
+auto DiskCache::size() const -> uint64_t
+{ return impl_->size(); }
+
+auto DiskCache::hit_count() const -> size_t
+{ return impl_->hit_count(); }
+
+auto DiskCache::miss_count() const -> size_t
+{ return impl_->miss_count(); }
+
+} // namespace gc
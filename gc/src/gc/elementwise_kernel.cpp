@@ -0,0 +1,90 @@
+/** @file
+ * @brief Kernels of nodes computing outputs element by element.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "gc/elementwise_kernel.hpp"
+#include "gc/parallel.hpp"
+
+#include "mpk/mix/util/throw.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+
+namespace gc {
+
+namespace {
+
+// Number of elements passed through all kernels of a chain at once
+constexpr size_t tile_size = 4096;
+
+} // anonymous namespace
+
+
+auto compute_elementwise_chain(std::span<const ElementwiseKernel> kernels,
+                               const mpk::mix::value::Value& input,
+                               mpk::mix::value::Value& output,
+                               const std::stop_token& stoken)
+    -> bool
+{
+    if (kernels.empty())
+        throw std::invalid_argument("Elementwise chain has no kernels");
+
+    for (size_t ik=1; ik<kernels.size(); ++ik)
+        if (kernels[ik].input_element_size !=
+            kernels[ik-1].output_element_size)
+            mpk::mix::throw_<std::invalid_argument>(
+                "Elementwise kernel {} takes elements of {} bytes, "
+                "but the previous kernel produces elements of {} bytes",
+                ik,
+                kernels[ik].input_element_size,
+                kernels[ik-1].output_element_size);
+
+    const auto& head = kernels.front();
+    const auto& tail = kernels.back();
+
+    auto shape = mpk::mix::value::Value{};
+    auto in = head.input_elements(input, shape);
+    auto out = tail.output_elements(output, shape);
+    auto n = in.size() / head.input_element_size;
+    if (out.size() != n * tail.output_element_size)
+        mpk::mix::throw_<std::invalid_argument>(
+            "Elementwise chain output has {} bytes, expected {}",
+            out.size(), n * tail.output_element_size);
+
+    auto scratch_size = size_t{};
+    for (const auto& k : kernels.first(kernels.size() - 1))
+        scratch_size = std::max(scratch_size, k.output_element_size);
+    scratch_size *= tile_size;
+
+    auto tile_count = (n + tile_size - 1) / tile_size;
+    auto process_tiles = [&](size_t begin, size_t end)
+    {
+        // Intermediate tiles alternate between the two halves
+        auto scratch = std::vector<std::byte>(2 * scratch_size);
+        for (auto itile=begin; itile<end; ++itile)
+        {
+            auto first = itile * tile_size;
+            auto count = std::min(tile_size, n - first);
+            const auto* src = in.data() + first * head.input_element_size;
+            for (size_t ik=0, nk=kernels.size(); ik<nk; ++ik)
+            {
+                const auto& k = kernels[ik];
+                auto* dst = ik + 1 == nk
+                    ? out.data() + first * k.output_element_size
+                    : scratch.data() + (ik % 2) * scratch_size;
+                k.apply(src, dst, count);
+                src = dst;
+            }
+        }
+    };
+
+    return parallel_for(tile_count, process_tiles, stoken);
+}
+
+} // namespace gc
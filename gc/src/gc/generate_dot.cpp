@@ -11,31 +11,22 @@
 #include "gc/generate_dot.hpp"
 
 #include "gc/activation_node.hpp"
+#include "gc/computation_node.hpp"
 
 #include "mpk/mix/util/throw.hpp"
 
+#include <algorithm>
+#include <format>
+
 
 namespace gc {
 
-auto generate_dot(std::ostream& s,
-                  const gc::ActivationGraph& g,
-                  gc::NodeLabels node_labels)
+namespace {
+
+template <typename Node>
+auto generate_dot_edges(std::ostream& s, const gc::Graph<Node>& g)
     -> void
 {
-    s << "digraph g {\n";
-
-    assert(node_labels.size() == g.nodes.size());
-    for (auto inode : g.nodes.index_range())
-    {
-        auto* node = g.nodes[inode].get();
-        auto label = node_labels[inode];
-        s << "  N" << inode
-          << " [label=\"" << inode << ": " << label
-          << "\\n(" << node->meta().type_name << ")\"]\n";
-    }
-
-    s << '\n';
-
     for (const auto& e : g.edges)
     {
         auto from_port_names = g.nodes.at(e.from.node)->output_names();
@@ -57,6 +48,71 @@ auto generate_dot(std::ostream& s,
           << " \" headlabel=\" " << int(e.to.port.v) << ':' << to_port_name
           << " \"]\n";
     }
+}
+
+} // anonymous namespace
+
+auto generate_dot(std::ostream& s,
+                  const gc::ActivationGraph& g,
+                  gc::NodeLabels node_labels)
+    -> void
+{
+    s << "digraph g {\n";
+
+    assert(node_labels.size() == g.nodes.size());
+    for (auto inode : g.nodes.index_range())
+    {
+        auto* node = g.nodes[inode].get();
+        auto label = node_labels[inode];
+        s << "  N" << inode
+          << " [label=\"" << inode << ": " << label
+          << "\\n(" << node->meta().type_name << ")\"]\n";
+    }
+
+    s << '\n';
+
+    generate_dot_edges(s, g);
+
+    s << "}\n";
+}
+
+auto generate_dot(std::ostream& s,
+                  const gc::ComputationGraph& g,
+                  gc::NodeLabels node_labels,
+                  const gc::ComputationProfile& profile)
+    -> void
+{
+    s << "digraph g {\n"
+         "  node [style=filled]\n";
+
+    assert(node_labels.size() == g.nodes.size());
+    assert(profile.nodes.size() == g.nodes.size());
+
+    auto total = profile.total_time();
+    auto max_time = std::chrono::nanoseconds{};
+    for (const auto& node : profile.nodes)
+        max_time = std::max(max_time, node.time);
+
+    for (auto inode : g.nodes.index_range())
+    {
+        const auto& node = profile.nodes[inode];
+        auto share = total.count() > 0
+            ? double(node.time.count()) / total.count()
+            : 0.;
+        auto saturation = max_time.count() > 0
+            ? double(node.time.count()) / max_time.count()
+            : 0.;
+        s << "  N" << inode
+          << " [label=\"" << inode << ": " << node_labels[inode]
+          << std::format("\\n{:.3f} ms, {:.1f}%",
+                         node.time.count() / 1e6, 100 * share)
+          << std::format("\" fillcolor=\"0.000 {:.3f} 1.000\"]\n",
+                         saturation);
+    }
+
+    s << '\n';
+
+    generate_dot_edges(s, g);
 
     s << "}\n";
 }
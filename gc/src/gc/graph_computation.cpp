@@ -10,22 +10,36 @@
 
 #include "gc/graph_computation.hpp"
 #include "gc/computation_node.hpp"
+#include "gc/computation_profile.hpp"
+#include "gc/disk_cache.hpp"
+#include "gc/elementwise_kernel.hpp"
+#include "gc/result_cache.hpp"
 #include "gc/strong_index.hpp"
 
+#include "common/thread_pool.hpp"
+
 #include "mpk/mix/func_ref/func_ref.hpp"
 #include "mpk/mix/util/index_range.hpp"
 #include "mpk/mix/log.hpp"
 #include "mpk/mix/util/throw.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cassert>
+#include <exception>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
 #include <ranges>
-#include <set>
+#include <span>
 #include <stdexcept>
 #include <unordered_map>
-
-#include <quill/std/Set.h>
+#include <utility>
 
 
 using namespace std::string_view_literals;
@@ -34,6 +48,29 @@ namespace gc {
 
 using namespace mpk::mix::value;
 
+// Edge of the flat execution plan: positions of the upstream output and of
+// the node input in flat arrays of result outputs and inputs (and input
+// references), precomputed and validated by `compile`.
+struct EdgeSlots final
+{
+    uint32_t output;
+    uint32_t input;
+    NodeIndex node;
+};
+
+// Edge coming to the in-place input of a node that takes over the upstream
+// output (see `CompileOptions::compute_in_place`)
+struct InPlaceEdge final
+{
+    EdgeSlots edge;
+
+    // Node the edge comes from
+    NodeIndex from;
+
+    // Output of the node `edge.node` computed in place
+    OutputPort output;
+};
+
 struct ComputationInstructions final
 {
     // i-th group contains node indices of i-th graph level
@@ -43,9 +80,49 @@ struct ComputationInstructions final
     // to nodes of level i+1
     mpk::mix::Grouped<Edge>           edges;
 
+    // Same as `edges`, in the form used by computations
+    mpk::mix::Grouped<EdgeSlots>      edge_slots;
+
     // i-th group contains indices of nodes supplying data
     // to the i-th node
     mpk::mix::StrongGrouped<NodeIndex, NodeIndex, Index>  sources;
+
+    // i-th group contains indices of nodes consuming data
+    // from the i-th node
+    mpk::mix::StrongGrouped<NodeIndex, NodeIndex, Index>  consumers;
+
+    // i-th group contains edges coming to the i-th node
+    mpk::mix::StrongGrouped<EdgeSlots, NodeIndex, Index>  node_edges;
+
+    // Position of each node in `nodes.values`, i.e., in topological order
+    mpk::mix::StrongVector<uint32_t, NodeIndex>           node_order;
+
+    // i-th group contains nodes of i-th chain of fused elementwise nodes,
+    // from the first one to the last one
+    mpk::mix::Grouped<NodeIndex>                          fused_chains;
+
+    // 1 + index of the fused chain each node belongs to, or 0; empty
+    // if there are no fused chains
+    mpk::mix::StrongVector<uint32_t, NodeIndex>           node_chain;
+
+    // Elements are true for nodes downstream of variable inputs, see
+    // `CompileOptions::variable_inputs`; empty if there are no such inputs
+    std::vector<bool>                                     dynamic;
+
+    // Same as `nodes` and `edge_slots`, but only for dynamic nodes
+    // and edges coming to them
+    mpk::mix::Grouped<NodeIndex>      dynamic_nodes;
+    mpk::mix::Grouped<EdgeSlots>      dynamic_edges;
+
+    // Number of dynamic nodes supplying data to each dynamic node
+    mpk::mix::StrongVector<uint32_t, NodeIndex>           dynamic_source_count;
+
+    // Set if memory planning is requested
+    std::optional<MemoryPlan>                             memory_plan;
+
+    // Edge whose upstream output each node takes over, if any; empty
+    // if no nodes are computed in place
+    mpk::mix::StrongVector<std::optional<InPlaceEdge>, NodeIndex> in_place;
 };
 
 auto operator<<(std::ostream& s, const ComputationInstructions& instr)
@@ -81,7 +158,9 @@ auto operator<<(std::ostream& s, const ComputationInstructions& instr)
 
 // -----------
 
-auto compile(const ComputationGraph& g, const SourceInputs& provided_inputs)
+auto compile(const ComputationGraph& g,
+             const SourceInputs& provided_inputs,
+             const CompileOptions& options)
     -> std::pair<ComputationInstructionsPtr, SourceInputs>
 {
     // GC_LOG_DEBUG(
@@ -93,227 +172,450 @@ auto compile(const ComputationGraph& g, const SourceInputs& provided_inputs)
     if (g.edges.empty() && g.nodes.empty())
         return { std::move(result), {} };
 
-    // Create a vector of raw pointers to graph nodes
-    // TODO: Get rid of it?
-    auto nodes = mpk::mix::StrongVector<const ComputationNode*, NodeIndex>{};
-    nodes.reserve(g.nodes.size());
-    std::ranges::transform(
-        g.nodes,
-        std::back_inserter(nodes),
-        [](const ComputationNodePtr& node) { return node.get(); });
+    const auto node_count = g.nodes.size().v;
+    const auto edge_count = g.edges.size();
 
-    // Map node pointers to their indices in g.nodes
-    std::unordered_map<const ComputationNode*, NodeIndex> node_ind;
-    for (auto i : nodes.index_range())
-        node_ind[nodes[i]] = i;
+    // Obtain node input and output counts; compute offsets of node inputs
+    // and outputs in the flat arrays of all inputs and outputs.
+    auto input_counts = std::vector<WeakPort>(node_count);
+    auto output_counts = std::vector<WeakPort>(node_count);
+    auto input_offsets = std::vector<uint32_t>(node_count + 1, 0);
+    auto output_offsets = std::vector<uint32_t>(node_count + 1, 0);
+    for (uint32_t i=0; i<node_count; ++i)
+    {
+        const auto& node = g.nodes[NodeIndex{i}];
+        input_counts[i] = node->input_count().v;
+        output_counts[i] = node->output_count().v;
+        input_offsets[i+1] = input_offsets[i] + input_counts[i];
+        output_offsets[i+1] = output_offsets[i] + output_counts[i];
+    }
 
     // Check edges
     auto check_edge_end = [&]<typename Tag>(const EdgeEnd<Tag>& ee)
     {
-        if(!nodes.index_range().contains(ee.node))
+        if(ee.node.v >= node_count)
             mpk::mix::throw_<std::out_of_range>(
                 "Edge end {} refers to a non-existent node",
                 ee);
 
-        const auto* node = nodes[ee.node];
         if constexpr (std::same_as<Tag, Input_Tag>)
         {
-            if (ee.port >= node->input_count())
+            if (ee.port.v >= input_counts[ee.node.v])
                 mpk::mix::throw_<std::invalid_argument>(
                     "Edge end {} refers to a non-existent input port",
                     ee);
         }
         else
         {
-            if (ee.port >= node->output_count())
+            if (ee.port.v >= output_counts[ee.node.v])
                 mpk::mix::throw_<std::invalid_argument>(
                     "Edge end {} refers to a non-existent output port",
                     ee);
         }
     };
 
-    auto check_edge = [&](const Edge& e)
+    // Track connections of all inputs by edges; count edges
+    // coming to each node.
+    auto connected_inputs = std::vector<bool>(input_offsets.back(), false);
+    auto in_degree = std::vector<uint32_t>(node_count, 0);
+    for (const auto& e : g.edges)
     {
         check_edge_end(e.from);
         check_edge_end(e.to);
-    };
 
-    std::ranges::for_each(g.edges, check_edge);
-
-    using BitVec = mpk::mix::StrongVector<bool, InputPort>;
+        auto connected = connected_inputs[input_offsets[e.to.node.v] + e.to.port.v];
+        if (connected)
+            mpk::mix::throw_<std::invalid_argument>(
+                "Edge end {} is not the only one coming to the input port",
+                e.to);
+        connected = true;
+        ++in_degree[e.to.node.v];
+    }
 
-    // Obtain information on node input and output counts.
-    struct NodeData
+    auto slots = [&](const Edge& e)
     {
-        InputPortCount input_count{};
-        OutputPortCount output_count{};
-        InputPortCount inputs_avail{};
-
-        // We will further track connections of all inputs & outputs by edges
-        BitVec connected_inputs{};
+        return EdgeSlots{
+            .output = output_offsets[e.from.node.v] + e.from.port.v,
+            .input = input_offsets[e.to.node.v] + e.to.port.v,
+            .node = e.to.node };
+    };
 
-        // Number of inputs connected to outputs of other nodes with graph edges
-        InputPortCount connected_input_count{};
+    // Sorts indices of edges by the value of `key` into buckets
+    // corresponding to nodes. Returns bucket offsets and edge indices.
+    auto bucket_edges = [&](auto key)
+        -> std::pair<std::vector<uint32_t>, std::vector<uint32_t>>
+    {
+        auto offsets = std::vector<uint32_t>(node_count + 1, 0);
+        for (const auto& e : g.edges)
+            ++offsets[key(e) + 1];
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        auto pos = offsets;
+        auto indices = std::vector<uint32_t>(edge_count);
+        for (uint32_t ie=0; ie<edge_count; ++ie)
+            indices[pos[key(g.edges[ie])]++] = ie;
+        return { std::move(offsets), std::move(indices) };
     };
-    auto node_data = mpk::mix::StrongVector<NodeData, NodeIndex>{};
-    node_data.reserve(nodes.size());
-    std::ranges::transform(
-        nodes,
-        std::back_inserter(node_data),
-        [](const ComputationNode* node) -> NodeData
-            { return { node->input_count(),
-                       node->output_count(),
-                       mpk::mix::Zero,
-                       BitVec(node->input_count(), false) }; } );
 
-    for (const auto& e : g.edges)
-        ++node_data.at(e.to.node).connected_input_count;
+    auto [out_offsets, out_edges] =
+        bucket_edges([](const Edge& e){ return e.from.node.v; });
+
+    // Kahn's algorithm, level by level. A node goes to the level next
+    // to the level of the last of its source nodes.
+    constexpr auto NoLevel = std::numeric_limits<uint32_t>::max();
+    auto node_level = std::vector<uint32_t>(node_count, NoLevel);
+    auto order = std::vector<uint32_t>{};
+    order.reserve(node_count);
+    for (uint32_t i=0; i<node_count; ++i)
+        if (in_degree[i] == 0)
+        {
+            node_level[i] = 0;
+            order.push_back(i);
+        }
+    if (order.empty())
+        throw std::invalid_argument("Graph has no sources");
 
-    auto has_all_inputs =
-        [&](gc::NodeIndex node_index)
+    auto level_offsets = std::vector<uint32_t>{ 0 };
+    for (uint32_t level=0; level_offsets.back() < order.size(); ++level)
+    {
+        auto begin = level_offsets.back();
+        auto end = static_cast<uint32_t>(order.size());
+        level_offsets.push_back(end);
+        for (auto k=begin; k<end; ++k)
         {
-            auto& d = node_data[node_index];
-            return d.inputs_avail == d.connected_input_count;
-        };
+            auto inode = order[k];
+            for (auto j=out_offsets[inode]; j<out_offsets[inode+1]; ++j)
+            {
+                auto to = g.edges[out_edges[j]].to.node.v;
+                if (--in_degree[to] == 0)
+                {
+                    node_level[to] = level + 1;
+                    order.push_back(to);
+                }
+            }
+        }
+        std::sort(order.begin() + begin, order.begin() + end);
+    }
 
-    using IndexSet = std::set<gc::NodeIndex>;
+    if (order.size() < node_count)
+    {
+        auto unreachable = std::vector<NodeIndex>{};
+        for (uint32_t i=0; i<node_count; ++i)
+            if (node_level[i] == NoLevel)
+                unreachable.push_back(NodeIndex{i});
 
-    const auto node_ind_range =
-        std::ranges::iota_view{WeakNodeIndex{}, nodes.size().v} |
-        std::views::transform( [](WeakNodeIndex x){ return NodeIndex{x}; } );
+        mpk::mix::throw_<std::invalid_argument>(
+            "Graph is not connected. Unreachable nodes are {}",
+            mpk::mix::format_seq(unreachable));
+    }
 
-    // Add all sources to the initial level of the graph
-    auto level = IndexSet{};
-    std::ranges::copy_if(
-        node_ind_range,
-        std::inserter(level, level.end()),
-        has_all_inputs);
-    if (level.empty())
-        throw std::invalid_argument("Graph has no sources");
+    auto level_count = level_offsets.size() - 1;
 
-    auto known = level;
+    // Fill node levels and find node positions in topological order
+    result->nodes.values.reserve(node_count);
+    result->node_order.resize(g.nodes.size());
+    for (size_t level=0; level<level_count; ++level)
+    {
+        for (auto k=level_offsets[level]; k<level_offsets[level+1]; ++k)
+        {
+            add_to_last_group(result->nodes, NodeIndex{order[k]});
+            result->node_order[NodeIndex{order[k]}] = k;
+        }
+        next_group(result->nodes);
+    }
 
-    auto process_edge = [&](const Edge& e)
+    assert(result->nodes.values.size() == node_count);
+
+    // Group edges by the levels of the nodes they come from
     {
-        const auto& e1 = e.to;
-        assert (node_data.index_range().contains(e1.node));
-        auto& ports = node_data[e1.node].connected_inputs;
-        if (ports.at(e1.port))
-            mpk::mix::throw_<std::invalid_argument>(
-                "Edge end {} is not the only one coming to the input port",
-                e1);
-        ports[e1.port] = true;
+        auto [level_edge_offsets, level_edges] = [&]
+        {
+            auto offsets = std::vector<uint32_t>(level_count + 1, 0);
+            for (const auto& e : g.edges)
+                ++offsets[node_level[e.from.node.v] + 1];
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+            auto pos = offsets;
+            auto edges = std::vector<Edge>(edge_count);
+            for (const auto& e : g.edges)
+                edges[pos[node_level[e.from.node.v]]++] = e;
+            return std::pair{ std::move(offsets), std::move(edges) };
+        }();
+
+        result->edges.values.reserve(edge_count);
+        for (size_t level=0; level+1<level_count; ++level)
+        {
+            auto begin = level_edges.begin() + level_edge_offsets[level];
+            auto end = level_edges.begin() + level_edge_offsets[level+1];
+            std::sort(begin, end);
+            for (auto it=begin; it!=end; ++it)
+            {
+                add_to_last_group(result->edges, *it);
+                add_to_last_group(result->edge_slots, slots(*it));
+            }
+            next_group(result->edges);
+            next_group(result->edge_slots);
+        }
+        assert(result->edges.values.size() == edge_count);
+    }
 
-        add_to_last_group(result->edges, e);
-    };
+    // Build source map, consumer map, and group edges by the nodes they
+    // come to.
+    auto [in_offsets, in_edges] =
+        bucket_edges([](const Edge& e){ return e.to.node.v; });
 
-    auto process_level = [&]
+    auto add_unique_nodes =
+        [](auto& grouped, std::vector<NodeIndex>& buf)
     {
-        for (auto inode : level)
-            add_to_last_group(result->nodes, inode);
-        next_group(result->nodes);
+        std::ranges::sort(buf);
+        auto tail = std::ranges::unique(buf);
+        buf.erase(tail.begin(), tail.end());
+        for (auto inode : buf)
+            add_to_last_group(grouped, inode);
+        next_group(grouped);
+        buf.clear();
     };
 
-    auto process_level_edges = [&]
+    auto buf = std::vector<NodeIndex>{};
+    auto edge_buf = std::vector<Edge>{};
+    for (uint32_t i=0; i<node_count; ++i)
     {
-        auto& edges = result->edges;
-        next_group(edges);
-        std::ranges::sort(group(edges, group_count(edges)-1));
-    };
+        for (auto j=in_offsets[i]; j<in_offsets[i+1]; ++j)
+        {
+            const auto& e = g.edges[in_edges[j]];
+            buf.push_back(e.from.node);
+            edge_buf.push_back(e);
+        }
+        add_unique_nodes(result->sources, buf);
 
-    process_level();
+        std::ranges::sort(edge_buf, {}, [](const Edge& e){ return e.to; });
+        for (const auto& e : edge_buf)
+            add_to_last_group(result->node_edges, slots(e));
+        next_group(result->node_edges);
+        edge_buf.clear();
 
-    // Process graph level by level
-    while (known.size() < nodes.size().v)
-    {
-        // GC_LOG_DEBUG("gc::compile: level: {}", level);
-        auto next_level = IndexSet{};
+        for (auto j=out_offsets[i]; j<out_offsets[i+1]; ++j)
+            buf.push_back(g.edges[out_edges[j]].to.node);
+        add_unique_nodes(result->consumers, buf);
+    }
 
-        for (const auto& e : g.edges)
+    // Find chains of elementwise nodes to fuse. A node is followed in
+    // a chain by the consumer of its only output, if the output is not
+    // to be kept and goes to the streamed input of the consumer only.
+    if (options.fuse_elementwise)
+    {
+        auto ports = std::vector<std::optional<ElementwisePorts>>(node_count);
+        for (uint32_t i=0; i<node_count; ++i)
+            ports[i] = g.nodes[NodeIndex{i}]->elementwise_ports();
+
+        constexpr auto NoNode = std::numeric_limits<uint32_t>::max();
+        auto next = std::vector<uint32_t>(node_count, NoNode);
+        auto has_prev = std::vector<bool>(node_count, false);
+        for (uint32_t i=0; i<node_count; ++i)
         {
-            const auto& [e0, e1] = e;
-
-            if (!level.contains(e0.node))
+            if (!ports[i] ||
+                output_counts[i] != 1 ||
+                out_offsets[i+1] - out_offsets[i] != 1)
                 continue;
 
-            if (known.contains(e1.node))
+            const auto& e = g.edges[out_edges[out_offsets[i]]];
+            const auto& consumer_ports = ports[e.to.node.v];
+            if (!consumer_ports ||
+                e.from.port != ports[i]->output ||
+                e.to.port != consumer_ports->input ||
+                std::ranges::find(options.keep_outputs, e.from) !=
+                    options.keep_outputs.end())
                 continue;
 
-            process_edge(e);
+            next[i] = e.to.node.v;
+            has_prev[e.to.node.v] = true;
+        }
 
-            // GC_LOG_DEBUG("gc::compile: {}", common::format(e));
+        for (uint32_t i=0; i<node_count; ++i)
+        {
+            if (has_prev[i] || next[i] == NoNode)
+                continue;
+            for (auto k=i; k!=NoNode; k=next[k])
+                add_to_last_group(result->fused_chains, NodeIndex{k});
+            next_group(result->fused_chains);
+        }
 
-            ++node_data[e1.node].inputs_avail;
-            if (has_all_inputs(e1.node))
-            {
-                // GC_LOG_DEBUG(
-                //     "gc::compile: node {} has all inputs ready", e1.inode);
-                assert(!next_level.contains(e1.node));
-                next_level.insert(e1.node);
-            }
+        if (!result->fused_chains.values.empty())
+        {
+            result->node_chain.resize(g.nodes.size());
+            auto nchains = group_count(result->fused_chains);
+            for (auto ichain=0u; ichain<nchains; ++ichain)
+                for (auto inode : group(result->fused_chains, ichain))
+                    result->node_chain[inode] = ichain + 1;
         }
+    }
 
-        process_level_edges();
+    // Find dynamic nodes, i.e., nodes downstream of variable inputs
+    if (!options.variable_inputs.empty())
+    {
+        auto& dynamic = result->dynamic;
+        dynamic.assign(node_count, false);
+        auto stack = std::vector<NodeIndex>{};
+        for (const auto& input : options.variable_inputs)
+        {
+            check_edge_end(input);
+            stack.push_back(input.node);
+        }
+        while (!stack.empty())
+        {
+            auto inode = stack.back();
+            stack.pop_back();
+            if (dynamic[inode.v])
+                continue;
+            dynamic[inode.v] = true;
+            for (auto consumer : group(result->consumers, inode))
+                stack.push_back(consumer);
+        }
 
-        if (next_level.empty())
+        auto nlevels = group_count(result->nodes);
+        for (auto level=0u; level<nlevels; ++level)
         {
-            auto unreachable = IndexSet{};
-            std::ranges::copy_if(
-                node_ind_range,
-                std::inserter(unreachable, unreachable.end()),
-                [&](gc::NodeIndex inode)
-                    { return !known.contains(inode); } );
+            for (auto inode : group(result->nodes, level))
+                if (dynamic[inode.v])
+                    add_to_last_group(result->dynamic_nodes, inode);
+            next_group(result->dynamic_nodes);
+        }
 
-            mpk::mix::throw_<std::invalid_argument>(
-                "Graph is not connected. Unreachable nodes are {}",
-                mpk::mix::format_seq(unreachable));
+        for (auto level=0u; level+1<nlevels; ++level)
+        {
+            for (const auto& e : group(result->edges, level))
+                if (dynamic[e.to.node.v])
+                    add_to_last_group(result->dynamic_edges, slots(e));
+            next_group(result->dynamic_edges);
         }
 
-        std::ranges::copy(next_level, std::inserter(known, known.end()));
-        std::swap(level, next_level);
-        process_level();
+        result->dynamic_source_count.resize(g.nodes.size());
+        for (auto inode : g.nodes.index_range())
+            for (auto source : group(result->sources, inode))
+                if (dynamic[source.v])
+                    ++result->dynamic_source_count[inode];
     }
 
-    assert(result->nodes.values.size() == g.nodes.size().v);
-
-    if(result->edges.values.size() != g.edges.size())
+    // Find nodes computed in place: the upstream output connected to
+    // the in-place input of such a node must go to that input only.
+    if (options.compute_in_place)
     {
-        auto& sorted_edges = result->edges.values;
-        auto is_edge_unprocessed = [&](const Edge& e)
+        auto output_edge_counts =
+            std::vector<uint32_t>(output_offsets.back(), 0);
+        for (const auto& e : g.edges)
+            ++output_edge_counts[slots(e).output];
+        for (const auto& o : options.keep_outputs)
+        {
+            check_edge_end(o);
+            output_edge_counts[output_offsets[o.node.v] + o.port.v] = 0;
+        }
+
+        auto fused = [&](NodeIndex inode)
         {
-            auto it = std::ranges::lower_bound(sorted_edges, e);
-            return it == sorted_edges.end() || *it != e;
+            return !result->node_chain.empty() &&
+                   result->node_chain[inode] != 0;
         };
-        std::ranges::sort(sorted_edges);
-        auto unprocessed_edges = std::set<Edge>{};
-        std::ranges::copy_if(
-            g.edges,
-            std::inserter(unprocessed_edges, unprocessed_edges.end()),
-            is_edge_unprocessed);
 
-        mpk::mix::throw_<std::invalid_argument>(
-            "The following edges are not processed because"
-            " the graph has a cycle: {}",
-            mpk::mix::format_seq(unprocessed_edges));
-    }
+        auto ports = std::vector<std::optional<InPlacePorts>>(node_count);
+        for (uint32_t i=0; i<node_count; ++i)
+            ports[i] = g.nodes[NodeIndex{i}]->in_place_ports();
 
-    // Build source map
-    using SimpleEdge = std::array<gc::NodeIndex, 2>; // to -> from
-    auto simple_edges = std::vector<SimpleEdge>{};
-    for (const auto& e : g.edges)
-        simple_edges.push_back({e.to.node, e.from.node});
-    std::sort(simple_edges.begin(), simple_edges.end());
-    simple_edges.resize(
-        std::unique(simple_edges.begin(), simple_edges.end()) -
-        simple_edges.begin());
+        auto in_place = mpk::mix::StrongVector<std::optional<InPlaceEdge>,
+                                               NodeIndex>(g.nodes.size());
+        auto found = false;
+        for (const auto& e : g.edges)
+        {
+            const auto& node_ports = ports[e.to.node.v];
+            auto s = slots(e);
+            if (!node_ports ||
+                node_ports->input != e.to.port ||
+                output_edge_counts[s.output] != 1 ||
+                fused(e.from.node) ||
+                fused(e.to.node) ||
+                std::ranges::find(options.variable_inputs, e.to) !=
+                    options.variable_inputs.end())
+                continue;
+
+            in_place[e.to.node] = InPlaceEdge{
+                .edge = s, .from = e.from.node, .output = node_ports->output };
+            found = true;
+        }
+        if (found)
+            result->in_place = std::move(in_place);
+    }
 
+    // Plan memory: find the level of the last consumer of each output
+    // and assign buffers to outputs level by level, reusing buffers
+    // of outputs released at previous levels.
+    if (options.plan_memory)
     {
-        auto ie = size_t{};
-        for (auto i : nodes.index_range())
+        auto& plan = result->memory_plan.emplace();
+
+        auto output_index = [&](const EdgeOutputEnd& o)
+        { return output_offsets[o.node.v] + o.port.v; };
+
+        constexpr auto Kept = std::numeric_limits<uint32_t>::max();
+        auto last_level = std::vector<uint32_t>(output_offsets.back(), Kept);
+        for (const auto& e : g.edges)
         {
-            for (; ie<simple_edges.size() && simple_edges[ie][0] == i; ++ie)
-                add_to_last_group(result->sources, simple_edges[ie][1]);
-            next_group(result->sources);
+            auto& level = last_level[output_index(e.from)];
+            auto consumer_level = node_level[e.to.node.v];
+            level = level == Kept ? consumer_level
+                                  : std::max(level, consumer_level);
+        }
+        for (const auto& o : options.keep_outputs)
+        {
+            check_edge_end(o);
+            last_level[output_index(o)] = Kept;
+        }
+
+        auto buffers = std::vector<uint32_t>(output_offsets.back());
+        auto releases = std::vector<std::vector<EdgeOutputEnd>>(level_count);
+        auto free_buffers = std::vector<uint32_t>{};
+        auto live = size_t{};
+        for (uint32_t level=0; level<level_count; ++level)
+        {
+            for (auto inode : group(result->nodes, level))
+                for (auto port : mpk::mix::index_range<OutputPort>(
+                                    g.nodes[inode]->output_count()))
+                {
+                    auto o = EdgeOutputEnd{ inode, port };
+                    auto& buffer = buffers[output_index(o)];
+                    auto release_level = last_level[output_index(o)];
+                    if (release_level == Kept)
+                    {
+                        buffer = MemoryPlan::no_buffer;
+                        ++plan.kept_output_count;
+                        continue;
+                    }
+                    if (free_buffers.empty())
+                        buffer = plan.buffer_count++;
+                    else
+                    {
+                        buffer = free_buffers.back();
+                        free_buffers.pop_back();
+                    }
+                    releases[release_level].push_back(o);
+                    ++live;
+                }
+
+            plan.peak_live_outputs = std::max(plan.peak_live_outputs, live);
+            for (const auto& o : releases[level])
+                free_buffers.push_back(buffers[output_index(o)]);
+            live -= releases[level].size();
+        }
+
+        plan.output_count = output_offsets.back();
+        plan.peak_live_outputs += plan.kept_output_count;
+        for (uint32_t i=0; i<node_count; ++i)
+        {
+            for (auto k=output_offsets[i]; k<output_offsets[i+1]; ++k)
+                add_to_last_group(plan.buffers, buffers[k]);
+            next_group(plan.buffers);
+        }
+        for (auto& level_releases : releases)
+        {
+            for (const auto& o : level_releases)
+                add_to_last_group(plan.releases, o);
+            next_group(plan.releases);
         }
     }
 
@@ -321,46 +623,39 @@ auto compile(const ComputationGraph& g, const SourceInputs& provided_inputs)
     // Start with provided inputs and augment with any missing ones.
     auto source_inputs = provided_inputs;
 
-    // Build a sorted vector
-    // of all destinations of inputs provided.
-    auto input_dst = provided_inputs.destinations.values;
-    std::ranges::sort(input_dst);
-
-    auto input_provided = [&](const EdgeInputEnd& dst)
-    {
-        auto it = std::ranges::lower_bound(input_dst, dst);
-        return it != input_dst.end() && *it == dst;
-    };
-
-    // Check that the destinations of inputs provided are valid
-    for (const auto& dst : input_dst)
+    // Check that the destinations of inputs provided are valid,
+    // and mark them.
+    auto input_provided = std::vector<bool>(input_offsets.back(), false);
+    for (const auto& dst : provided_inputs.destinations.values)
     {
-        if(!nodes.index_range().contains(dst.node))
+        if(dst.node.v >= node_count)
             mpk::mix::throw_<std::out_of_range>(
                 "Source input destination {} refers to a non-existent node",
                 dst);
 
-        if (dst.port >= InputPort{} + nodes[dst.node]->input_count())
+        if (dst.port.v >= input_counts[dst.node.v])
             mpk::mix::throw_<std::invalid_argument>(
                 "Source input destination {} refers to a non-existent input port",
                 dst);
+
+        input_provided[input_offsets[dst.node.v] + dst.port.v] = true;
     }
 
     // Check that provided inputs do not specify destinations
     // coincident with any edge targets. Add inputs that were not
     // provided.
-    for (auto i : nodes.index_range())
+    for (auto i : g.nodes.index_range())
     {
-        const auto& nd = node_data[i];
-        const auto* node = nodes[i];
+        const auto* node = g.nodes[i].get();
+        auto input_offset = input_offsets[i.v];
         using InputValueVec = mpk::mix::StrongVector<Value, InputPort>;
         auto default_inputs = InputValueVec(node->input_count());
-        nodes[i]->default_inputs(default_inputs);
+        node->default_inputs(default_inputs);
         for (auto port : default_inputs.index_range())
         {
             auto dst = EdgeInputEnd{i, port};
-            auto provided = input_provided(dst);
-            if (nd.connected_inputs[port])
+            auto provided = input_provided[input_offset + port.v];
+            if (connected_inputs[input_offset + port.v])
             {
                 if (provided)
                     mpk::mix::throw_<std::invalid_argument>(
@@ -374,8 +669,10 @@ auto compile(const ComputationGraph& g, const SourceInputs& provided_inputs)
             if (provided)
                 continue;
 
-            source_inputs.values.push_back(default_inputs[port]);
-            add_to_last_group(source_inputs.destinations, EdgeInputEnd{i,port});
+            source_inputs.values.push_back(std::move(default_inputs[port]));
+            if (!provided_inputs.versions.empty())
+                source_inputs.versions.push_back(new_source_input_version());
+            add_to_last_group(source_inputs.destinations, dst);
             next_group(source_inputs.destinations);
         }
     }
@@ -383,48 +680,68 @@ auto compile(const ComputationGraph& g, const SourceInputs& provided_inputs)
     return { std::move(result), std::move(source_inputs) };
 }
 
-auto compute(ComputationResult& result,
-             const ComputationGraph& g,
-             const ComputationInstructions* instructions,
-             const SourceInputs& source_inputs)
-    -> void
-{ compute(result, g, instructions, source_inputs, {}, {}); }
-
-auto compute(ComputationResult& result,
-             const ComputationGraph& g,
-             const ComputationInstructions* instructions,
-             const SourceInputs& source_inputs,
-             const std::stop_token& stoken,
-             const GraphProgress& progress)
-    -> bool
+auto memory_plan(const ComputationInstructions& instructions)
+    -> const MemoryPlan*
 {
-    auto input_count =
-       [](const gc::ComputationNode& node){ return node.input_count(); };
-    auto output_count =
-       [](const gc::ComputationNode& node){ return node.output_count(); };
+    return instructions.memory_plan ? &*instructions.memory_plan : nullptr;
+}
 
-    if (result.outputs.v.values.empty())
+namespace {
+
+auto node_input_count(const ComputationNode& node)
+    -> InputPortCount
+{ return node.input_count(); }
+
+auto node_output_count(const ComputationNode& node)
+    -> OutputPortCount
+{ return node.output_count(); }
+
+// Allocates result data for graph `g`; all nodes are outdated.
+auto allocate_result(ComputationResult& result, const ComputationGraph& g)
+    -> void
+{
+    auto fill = [&]<typename T, typename IO, typename II>(
+                    mpk::mix::StrongGrouped<T, IO, II>& grouped, auto count)
     {
-        // Allocate result grouped data
-        auto fill = [&]<typename T, typename IO, typename II>(
-                        mpk::mix::StrongGrouped<T, IO, II>& grouped, auto count)
+        grouped = {};
+        for (const auto& node : g.nodes)
         {
-            grouped = {};
-            for (const auto& node : g.nodes)
-            {
-                for (auto _ : mpk::mix::index_range<II>(count(*node)))
-                    mpk::mix::add_to_last_group(grouped, T{});
-                mpk::mix::next_group(grouped);
-            }
-        };
+            for (auto _ : mpk::mix::index_range<II>(count(*node)))
+                mpk::mix::add_to_last_group(grouped, T{});
+            mpk::mix::next_group(grouped);
+        }
+    };
 
-        fill(result.inputs, input_count);
-        fill(result.outputs, output_count);
-        fill(result.prev_source_outputs, output_count);
-        result.node_ts =
-            mpk::mix::StrongVector<Timestamp, NodeIndex>(g.nodes.size(), 0);
-        result.computation_ts = 0;
-    }
+    fill(result.inputs, node_input_count);
+    fill(result.input_refs, node_input_count);
+    fill(result.outputs, node_output_count);
+    result.node_ts =
+        mpk::mix::StrongVector<Timestamp, NodeIndex>(g.nodes.size(), 0);
+    result.changed_ts =
+        mpk::mix::StrongVector<Timestamp, NodeIndex>(g.nodes.size(), 0);
+    result.output_fingerprints =
+        mpk::mix::StrongVector<uint64_t, NodeIndex>(g.nodes.size(), 0);
+    result.updated_ts =
+        mpk::mix::StrongVector<Timestamp, NodeIndex>(g.nodes.size(), 0);
+    result.visited_ts =
+        mpk::mix::StrongVector<Timestamp, NodeIndex>(g.nodes.size(), 0);
+    result.input_updated_ts.assign(result.inputs.v.values.size(), 0);
+    result.computation_ts = 0;
+    result.complete_ts = 0;
+    result.source_versions.clear();
+    result.input_refs_base = nullptr;
+}
+
+// Allocates or validates result data, increments computation timestamp,
+// and sets source inputs. Nodes whose inputs have been updated are marked
+// in `result.updated_ts` and listed in `result.updated_nodes`.
+auto prepare_result(ComputationResult& result,
+                    const ComputationGraph& g,
+                    const SourceInputs& source_inputs)
+    -> void
+{
+    if (result.outputs.v.values.empty())
+        allocate_result(result, g);
 
     else
     {
@@ -437,20 +754,77 @@ auto compute(ComputationResult& result,
                 assert(group(grouped, inode).size() == count(*g.nodes[inode]));
         };
 
-        check(result.inputs, input_count);
-        check(result.outputs, output_count);
-        check(result.prev_source_outputs, output_count);
+        check(result.inputs, node_input_count);
+        check(result.input_refs, node_input_count);
+        check(result.outputs, node_output_count);
         assert(result.node_ts.size() == g.nodes.size());
+        assert(result.changed_ts.size() == g.nodes.size());
+        assert(result.output_fingerprints.size() == g.nodes.size());
+        assert(result.updated_ts.size() == g.nodes.size());
+        assert(result.visited_ts.size() == g.nodes.size());
+        assert(result.input_updated_ts.size() == result.inputs.v.values.size());
     }
 
-    ++result.computation_ts;
+    if (result.profile && result.profile->nodes.size() != g.nodes.size())
+        result.profile->nodes.resize(g.nodes.size());
+
+    if (!result.active_nodes.empty() &&
+        result.active_nodes.size() != g.nodes.size().v)
+        mpk::mix::throw_<std::invalid_argument>(
+            "Active node mask has {} elements, expected {}",
+            result.active_nodes.size(), g.nodes.size().v);
 
-    auto source_updated =
-        mpk::mix::StrongVector<bool, NodeIndex>(g.nodes.size(), false);
+    // Bind inputs to their own storage. Inputs connected to upstream
+    // outputs are rebound by `transfer_edge`.
+    auto& input_values = result.inputs.v.values;
+    if (result.input_refs_base != input_values.data())
+    {
+        auto& refs = result.input_refs.v.values;
+        assert(refs.size() == input_values.size());
+        for (size_t i=0, n=refs.size(); i<n; ++i)
+            refs[i] = &input_values[i];
+        result.input_refs_base = input_values.data();
+    }
+
+    auto ts = ++result.computation_ts;
+
+    result.updated_nodes.clear();
+    auto mark_updated = [&](NodeIndex inode)
+    {
+        auto& updated_ts = result.updated_ts.at(inode);
+        if (updated_ts == ts)
+            return;
+        updated_ts = ts;
+        result.updated_nodes.push_back(inode);
+    };
 
-    // Set external inputs
-    for (size_t i=0, n=source_inputs.values.size(); i<n; ++i)
+    // Set external inputs. If source inputs have version stamps, only those
+    // with stamps different from ones seen last time are set; otherwise,
+    // values are compared.
+    const auto n = source_inputs.values.size();
+    const auto versioned = !source_inputs.versions.empty();
+    if (versioned)
     {
+        if (source_inputs.versions.size() != n)
+            mpk::mix::throw_<std::invalid_argument>(
+                "Source inputs have {} version stamps, expected {}",
+                source_inputs.versions.size(), n);
+        if (result.source_versions.size() != n)
+            result.source_versions.assign(n, 0);
+    }
+    else
+        result.source_versions.clear();
+
+    for (size_t i=0; i<n; ++i)
+    {
+        if (versioned)
+        {
+            auto version = source_inputs.versions[i];
+            if (result.source_versions[i] == version)
+                continue;
+            result.source_versions[i] = version;
+        }
+
         const auto& value = source_inputs.values[i];
 
         for (auto d : group(source_inputs.destinations, i))
@@ -465,81 +839,798 @@ auto compute(ComputationResult& result,
                     "Source input {} refers to an inexistent input port",
                     d);
             auto& node_input = node_inputs[d.port];
-            if (node_input != value)
+            if (versioned || node_input != value)
             {
                 node_input = value;
-                source_updated[d.node] = true;
+                mark_updated(d.node);
             }
         }
+    }
+
+    // Mark updated inputs, so that edges need no lookups in the set
+    const auto* input_base = result.inputs.v.values.data();
+    for (const auto& e1 : result.updated_inputs)
+    {
+        if (!g.nodes.index_range().contains(e1.node))
+            mpk::mix::throw_<std::out_of_range>(
+                "Updated input {} refers to an inexistent graph node",
+                e1);
+        auto node_inputs = group(result.inputs, e1.node);
+        if (!node_inputs.index_range().contains(e1.port))
+            mpk::mix::throw_<std::out_of_range>(
+                "Updated input {} refers to an inexistent input port",
+                e1);
+        result.input_updated_ts[&node_inputs[e1.port] - input_base] = ts;
+        mark_updated(e1.node);
+    }
+}
+
+auto transfer_edge(ComputationResult& result, const EdgeSlots& e)
+    -> void
+{
+    auto& ref = result.input_refs.v.values[e.input];
+    if (result.input_updated_ts[e.input] == result.computation_ts)
+    {
+        // Do not bind node input to upstream output
+        // for updated inputs, because we should assume
+        // that such inputs are already updated manually;
+        // reset node timestamp to force its recalculation.
+        ref = &result.inputs.v.values[e.input];
+        result.node_ts[e.node] = Timestamp{};
+    }
+    else
+        ref = &result.outputs.v.values[e.output];
+}
+
+auto node_inputs(const ComputationResult& result, NodeIndex inode)
+    -> ConstInputValues
+{
+    auto refs = group(result.input_refs, inode);
+    if (refs.empty())
+        return {};
+    return { &refs.front(), refs.size() };
+}
+
+// Updates the hash of outputs of node `inode` that has just been computed;
+// returns true if the hash is the same as before.
+auto same_outputs(ComputationResult& result, NodeIndex inode)
+    -> bool
+{
+    auto& prev = result.output_fingerprints[inode];
+    if (!result.fingerprint)
+    {
+        prev = 0;
+        return false;
+    }
+
+    auto fingerprint = Fingerprint{};
+    for (const auto& output : group(result.outputs, inode))
+    {
+        auto hash = result.fingerprint(output);
+        if (hash == 0)
+        {
+            prev = 0;
+            return false;
+        }
+        fingerprint.add(hash);
+    }
+
+    auto same = prev == fingerprint.value();
+    prev = fingerprint.value();
+    return same;
+}
+
+// Computes node `inode` of a fused chain. The output of the chain is
+// computed when its last node is computed; outputs of other nodes of
+// the chain are never computed.
+auto compute_fused_node(ComputationResult& result,
+                        const ComputationGraph& g,
+                        const ComputationInstructions& instructions,
+                        NodeIndex inode,
+                        const std::stop_token& stoken)
+    -> bool
+{
+    auto chain =
+        group(instructions.fused_chains, instructions.node_chain[inode] - 1);
+    if (inode != chain.back())
+        return true;
+
+    auto kernels = std::vector<ElementwiseKernel>{};
+    kernels.reserve(chain.size());
+    for (auto member : chain)
+    {
+        // Edges coming to other nodes of the chain are not transferred
+        // by `compute_dirty` unless these nodes are outdated.
+        for (const auto& e : group(instructions.node_edges, member))
+            transfer_edge(result, e);
+        kernels.push_back(
+            g.nodes[member]->elementwise_kernel(node_inputs(result, member)));
+    }
+
+    auto head = chain.front();
+    auto input_port = g.nodes[head]->elementwise_ports()->input;
+    auto output_port = g.nodes[inode]->elementwise_ports()->output;
+    return compute_elementwise_chain(
+        kernels,
+        node_inputs(result, head)[input_port],
+        group(result.outputs, inode)[output_port],
+        stoken);
+}
+
+// Hands the storage of the upstream output over to the output of the node
+// computed in place, and binds the in-place input to that output, unless
+// the input has been updated manually. The upstream node is going to be
+// recomputed by the next computation.
+auto take_over_input(ComputationResult& result, const InPlaceEdge& e)
+    -> void
+{
+    auto& ref = result.input_refs.v.values[e.edge.input];
+    auto& upstream = result.outputs.v.values[e.edge.output];
+    if (ref != &upstream)
+        return;
+
+    auto& output = group(result.outputs, e.edge.node)[e.output];
+    output = std::exchange(upstream, {});
+    ref = &output;
+    result.node_ts[e.from] = Timestamp{};
+}
+
+// Returns true if an input of node `inode` has been updated manually
+// for the current computation (see `ComputationResult::updated_inputs`)
+auto has_updated_inputs(const ComputationResult& result, NodeIndex inode)
+    -> bool
+{
+    auto inputs = group(result.inputs, inode);
+    if (inputs.empty())
+        return false;
+    auto first = &inputs[InputPort{ 0 }] - result.inputs.v.values.data();
+    auto updated_ts = std::span{ result.input_updated_ts }.subspan(
+        first, inputs.size().v);
+    return std::ranges::find(updated_ts, result.computation_ts) !=
+           updated_ts.end();
+}
+
+// Computes node `inode` if it is outdated. Inputs of the node must already
+// be transferred from upstream outputs.
+// Makes node `inode`, whose computation has been interrupted, outdated:
+// its outputs may be partially overwritten, and updates of its inputs
+// are forgotten once they are cleared, so the node has to be computed
+// by the next computation in any case. Returns false.
+auto mark_interrupted(ComputationResult& result, NodeIndex inode)
+    -> bool
+{
+    result.node_ts[inode] = Timestamp{};
+    result.output_fingerprints[inode] = 0;
+    return false;
+}
+
+auto compute_node(ComputationResult& result,
+                  const ComputationGraph& g,
+                  const ComputationInstructions& instructions,
+                  NodeIndex inode,
+                  const std::stop_token& stoken,
+                  const GraphProgress& progress)
+    -> bool
+{
+    if (!result.active_nodes.empty() && !result.active_nodes[inode.v])
+    {
+        // Updated source inputs are not seen by later computations,
+        // so make sure the node is computed once it is active again
+        if (result.updated_ts[inode] == result.computation_ts)
+            result.node_ts[inode] = Timestamp{};
+        return true;
+    }
+
+    Timestamp upstream_ts;
 
-        for (const auto& e1 : result.updated_inputs)
-            source_updated.at(e1.node) = true;
+    // Check if a source input of the node `inode` has been updated
+    auto node_ts = result.node_ts[inode];
+    auto upstream_updated =
+        result.updated_ts[inode] == result.computation_ts ||
+        node_ts == Timestamp{};
+    if (upstream_updated)
+        upstream_ts = result.computation_ts;
+    else
+    {
+        // If no source inputs have been updated,
+        // also check if any of source nodes has been updated
+        upstream_ts = node_ts;
+        for (auto i : group(instructions.sources, inode))
+            upstream_ts = std::max(upstream_ts, result.changed_ts[i]);
+        upstream_updated = node_ts < upstream_ts;
     }
 
-    auto nlevels = group_count(instructions->nodes);
+    auto* profile = result.profile.get();
+
+    if (!upstream_updated)
+    {
+        if (profile)
+            ++profile->nodes[inode].skip_count;
+        return true;
+    }
+
+    auto start_time = profile
+        ? std::chrono::steady_clock::now()
+        : std::chrono::steady_clock::time_point{};
+
+    auto node_progress =
+        [&](double progress_value)
+    { progress(inode, progress_value); };
+    auto node_progress_func = progress
+        ? NodeProgress{ &node_progress }
+        : NodeProgress{};
+
+    const auto& node = g.nodes[inode];
+    auto outputs = group(result.outputs, inode);
+    auto inputs = node_inputs(result, inode);
+    auto fused =
+        !instructions.node_chain.empty() && instructions.node_chain[inode] != 0;
+    if (fused)
+    {
+        if (!compute_fused_node(result, g, instructions, inode, stoken))
+            return mark_interrupted(result, inode);
+    }
+    else
+    {
+        // Nodes made outdated or having inputs updated manually are
+        // recomputed on purpose (e.g., to reset the evolution, or to reload
+        // a file), so caches are bypassed for them. Nodes not determined
+        // by their inputs are never memoized.
+        auto forced =
+            node_ts == Timestamp{} || has_updated_inputs(result, inode);
+        auto* cache = result.cache && !forced && node->cacheable()
+            ? result.cache.get()
+            : nullptr;
+        auto persistent_id = result.disk_cache && !forced
+            ? node->persistent_cache_id()
+            : std::string{};
+        auto cached =
+            (cache && cache->find(node.get(), inputs, outputs)) ||
+            (!persistent_id.empty() &&
+             result.disk_cache->find(persistent_id, inputs, outputs));
+        if (!cached)
+        {
+            // Values of cached inputs must stay as they are
+            auto in_place = !instructions.in_place.empty() &&
+                            !result.cache && !result.disk_cache
+                ? instructions.in_place[inode]
+                : std::nullopt;
+            if (in_place)
+                take_over_input(result, *in_place);
+
+            auto computed = node->compute_outputs(
+                outputs, inputs, stoken, node_progress_func);
+
+            if (!computed)
+                return mark_interrupted(result, inode);
+
+            if (cache)
+                cache->insert(node, inputs, outputs);
+
+            if (!persistent_id.empty())
+                result.disk_cache->insert(persistent_id, inputs, outputs);
+        }
+    }
+
+    if (profile)
+    {
+        auto& node_profile = profile->nodes[inode];
+        node_profile.time += std::chrono::steady_clock::now() - start_time;
+        ++node_profile.call_count;
+        for (const auto& e : group(instructions.node_edges, inode))
+        {
+            const auto& value = *result.input_refs.v.values[e.input];
+            node_profile.edge_bytes += profile->value_size
+                ? profile->value_size(value)
+                : sizeof(value);
+        }
+    }
+
+    // Outputs of fused nodes other than the last one are not computed,
+    // so they cannot be compared
+    auto unchanged = !fused && same_outputs(result, inode);
+    if (unchanged && profile)
+        ++profile->nodes[inode].cutoff_count;
+
+    result.node_ts[inode] = upstream_ts;
+    if (!unchanged)
+        result.changed_ts[inode] = upstream_ts;
+    return true;
+}
+
+// Gives empty planned outputs of node `inode` the storage released
+// by previous outputs planned in the same buffers (see `MemoryPlan`).
+auto acquire_buffers(ComputationResult& result,
+                     const MemoryPlan& plan,
+                     NodeIndex inode)
+    -> void
+{
+    auto buffers = group(plan.buffers, inode);
+    auto outputs = group(result.outputs, inode);
+    for (auto port : outputs.index_range())
+    {
+        auto buffer = buffers[port];
+        if (buffer != MemoryPlan::no_buffer && !outputs[port].type())
+            outputs[port] = std::exchange(result.spare_buffers[buffer], {});
+    }
+}
+
+// Moves the storage of a planned output to the spare buffer, so that the
+// next output planned in the same buffer can reuse it. The node is going
+// to be recomputed by the next computation.
+auto release_output(ComputationResult& result,
+                    const MemoryPlan& plan,
+                    const EdgeOutputEnd& output)
+    -> void
+{
+    auto [node, port] = output;
+    auto buffer = group(plan.buffers, node)[port];
+    assert(buffer != MemoryPlan::no_buffer);
+    result.spare_buffers[buffer] =
+        std::exchange(group(result.outputs, node)[port], {});
+    result.node_ts[node] = Timestamp{};
+}
+
+// Returns true if only dynamic nodes have to be visited by the current
+// computation (see `CompileOptions::variable_inputs`): static nodes have
+// been computed by the previous computation, which has not been interrupted,
+// and none of them has updated inputs.
+auto folded(const ComputationResult& result,
+            const ComputationInstructions& instructions)
+    -> bool
+{
+    if (instructions.dynamic.empty() ||
+        result.complete_ts + 1 != result.computation_ts)
+        return false;
+
+    return std::ranges::all_of(
+        result.updated_nodes,
+        [&](NodeIndex inode){ return instructions.dynamic[inode.v]; });
+}
+
+// Called when a computation has not been interrupted. Computations releasing
+// outputs according to the memory plan, or taking them over by nodes
+// computed in place, are not complete. Inactive nodes do not prevent
+// completeness: those with updated inputs are made outdated by
+// `compute_node`, and changing the set of active nodes makes the result
+// incomplete (see `request_outputs`).
+auto mark_complete(ComputationResult& result,
+                   const ComputationInstructions& instructions)
+    -> void
+{
+    auto released =
+        (instructions.memory_plan &&
+         instructions.memory_plan->buffer_count > 0) ||
+        !instructions.in_place.empty();
+    if (!released)
+        result.complete_ts = result.computation_ts;
+}
+
+} // anonymous namespace
+
+auto compute(ComputationResult& result,
+             const ComputationGraph& g,
+             const ComputationInstructions* instructions,
+             const SourceInputs& source_inputs)
+    -> void
+{ compute(result, g, instructions, source_inputs, {}, {}); }
+
+auto compute(ComputationResult& result,
+             const ComputationGraph& g,
+             const ComputationInstructions* instructions,
+             const SourceInputs& source_inputs,
+             const std::stop_token& stoken,
+             const GraphProgress& progress)
+    -> bool
+{
+    prepare_result(result, g, source_inputs);
+
+    auto is_folded = folded(result, *instructions);
+    const auto& nodes =
+        is_folded ? instructions->dynamic_nodes : instructions->nodes;
+    const auto& edges =
+        is_folded ? instructions->dynamic_edges : instructions->edge_slots;
+
+    const auto* plan = memory_plan(*instructions);
+    if (plan)
+        result.spare_buffers.resize(plan->buffer_count);
+
+    auto nlevels = group_count(nodes);
     for (auto level=0u; level<nlevels; ++level)
     {
         if (level > 0u)
         {
-            for (const auto& e : group(instructions->edges, level-1))
-            {
-                const auto& [e0, e1] = e;
-                if (result.updated_inputs.contains(e1))
-                    // Do not transfer upstream output to node input
-                    // for updated inputs, because we should assume
-                    // that such inputs are already updated manually;
-                    // reset node timestamp to force its recalculation.
-                    result.node_ts[e1.node] = Timestamp{};
-                else
-                    group(result.inputs, e1.node)[e1.port] =
-                        group(result.outputs, e0.node)[e0.port];
-            }
+            for (const auto& e : group(edges, level-1))
+                transfer_edge(result, e);
         }
 
-        for (auto inode : group(instructions->nodes, level))
+        for (auto inode : group(nodes, level))
         {
-            Timestamp upstream_ts;
+            if (plan)
+                acquire_buffers(result, *plan, inode);
+            if (!compute_node(result, g, *instructions,
+                              inode, stoken, progress))
+                return false;
+        }
 
-            // Check if a source input of the node `inode` has been updated
-            auto node_ts = result.node_ts[inode];
-            auto upstream_updated = source_updated[inode] ||
-                                    node_ts == Timestamp{};
-            if (upstream_updated)
-                upstream_ts = result.computation_ts;
-            else
+        if (plan)
+            for (const auto& output : group(plan->releases, level))
+                release_output(result, *plan, output);
+    }
+
+    mark_complete(result, *instructions);
+    return true;
+}
+
+auto compute(ComputationResult& result,
+             const ComputationGraph& g,
+             const ComputationInstructions* instructions,
+             const SourceInputs& source_inputs,
+             const std::stop_token& stoken,
+             const GraphProgress& progress,
+             common::ThreadPool& pool)
+    -> bool
+{
+    prepare_result(result, g, source_inputs);
+
+    auto node_count = g.nodes.size().v;
+    if (node_count == 0)
+    {
+        mark_complete(result, *instructions);
+        return true;
+    }
+
+    // Static nodes are not run at all if the computation is folded,
+    // and all consumers of dynamic nodes are dynamic.
+    auto is_folded = folded(result, *instructions);
+
+    // Number of source nodes not computed yet, for each node
+    auto pending =
+        std::make_unique<std::atomic<uint32_t>[]>(node_count);
+    for (auto inode : g.nodes.index_range())
+        pending[inode.v].store(
+            is_folded
+                ? instructions->dynamic_source_count[inode]
+                : group(instructions->sources, inode).size().v,
+            std::memory_order_relaxed);
+
+    auto remaining = std::atomic<size_t>{
+        is_folded ? instructions->dynamic_nodes.values.size() : node_count };
+    auto failed = std::atomic<bool>{ false };
+    auto error_mutex = std::mutex{};
+    auto error = std::exception_ptr{};
+
+    // With the memory plan, outputs of a node are released once all of its
+    // consumers have finished; buffers are handed over under the mutex,
+    // since nodes sharing a buffer in the plan may run concurrently.
+    const auto* plan = memory_plan(*instructions);
+    auto unconsumed = std::unique_ptr<std::atomic<uint32_t>[]>{};
+    auto buffer_mutex = std::mutex{};
+    if (plan)
+    {
+        result.spare_buffers.resize(plan->buffer_count);
+        unconsumed = std::make_unique<std::atomic<uint32_t>[]>(node_count);
+        for (auto inode : g.nodes.index_range())
+            unconsumed[inode.v].store(
+                group(instructions->consumers, inode).size().v,
+                std::memory_order_relaxed);
+    }
+    auto release_outputs = [&](NodeIndex inode)
+    {
+        auto lock = std::lock_guard{ buffer_mutex };
+        auto buffers = group(plan->buffers, inode);
+        for (auto port : buffers.index_range())
+            if (buffers[port] != MemoryPlan::no_buffer)
+                release_output(result, *plan, { inode, port });
+    };
+
+    auto run_node = std::function<void(NodeIndex)>{};
+    run_node = [&](NodeIndex inode)
+    {
+        if (!failed.load(std::memory_order_acquire))
+        {
+            try {
+                for (const auto& e : group(instructions->node_edges, inode))
+                    transfer_edge(result, e);
+
+                if (plan)
+                {
+                    auto lock = std::lock_guard{ buffer_mutex };
+                    acquire_buffers(result, *plan, inode);
+                }
+
+                if (!compute_node(result, g, *instructions,
+                                  inode, stoken, progress))
+                    failed.store(true, std::memory_order_release);
+            }
+            catch (...)
             {
-                // If no source inputs have been updated,
-                // also check if any of source nodes has been updated
-                upstream_ts = node_ts;
-                for (auto i : group(instructions->sources, inode))
-                    upstream_ts = std::max(upstream_ts, result.node_ts[i]);
-                upstream_updated = node_ts < upstream_ts;
+                auto lock = std::lock_guard{ error_mutex };
+                if (!error)
+                    error = std::current_exception();
+                failed.store(true, std::memory_order_release);
             }
+        }
 
-            if (!upstream_updated)
-                continue;
+        if (plan)
+            for (auto source : group(instructions->sources, inode))
+                if (unconsumed[source.v].fetch_sub(
+                        1, std::memory_order_acq_rel) == 1)
+                    release_outputs(source);
 
-            auto node_progress =
-                [&](double progress_value)
-            { progress(inode, progress_value); };
-            auto node_progress_func = progress
-                ? NodeProgress{ &node_progress }
-                : NodeProgress{};
+        for (auto consumer : group(instructions->consumers, inode))
+            if (pending[consumer.v].fetch_sub(
+                    1, std::memory_order_acq_rel) == 1)
+                pool.submit([&run_node, consumer]{ run_node(consumer); });
 
-            auto computed =
-                g.nodes[inode]->compute_outputs(
-                    group(result.outputs, inode),
-                    group(result.inputs, inode),
-                    stoken, node_progress_func);
+        remaining.fetch_sub(1, std::memory_order_acq_rel);
+    };
 
-            if (!computed)
-                return false;
+    if (is_folded)
+    {
+        for (auto inode : instructions->dynamic_nodes.values)
+            if (instructions->dynamic_source_count[inode] == 0)
+                pool.submit([&run_node, inode]{ run_node(inode); });
+    }
+    else
+        for (auto inode : group(instructions->nodes, 0))
+            pool.submit([&run_node, inode]{ run_node(inode); });
 
-            result.node_ts[inode] = upstream_ts;
-        }
+    pool.run_until(
+        [&]{ return remaining.load(std::memory_order_acquire) == 0; });
+
+    if (error)
+        std::rethrow_exception(error);
+
+    if (failed.load(std::memory_order_acquire))
+        return false;
+
+    mark_complete(result, *instructions);
+    return true;
+}
+
+auto compute_dirty(ComputationResult& result,
+                   const ComputationGraph& g,
+                   const ComputationInstructions* instructions,
+                   const SourceInputs& source_inputs,
+                   const std::stop_token& stoken,
+                   const GraphProgress& progress)
+    -> bool
+{
+    // All nodes have to be checked after result allocation or reset,
+    // and after an interrupted computation
+    auto full_scan =
+        result.computation_ts == Timestamp{} ||
+        result.complete_ts != result.computation_ts;
+    if (full_scan)
+        return compute(
+            result, g, instructions, source_inputs, stoken, progress);
+
+    prepare_result(result, g, source_inputs);
+    auto ts = result.computation_ts;
+
+    // Visit nodes reachable from updated nodes in topological order
+    auto& frontier = result.frontier;
+    frontier.clear();
+    auto later = [&](NodeIndex a, NodeIndex b)
+    {
+        return instructions->node_order[a] > instructions->node_order[b];
+    };
+    auto visit = [&](NodeIndex inode)
+    {
+        auto& visited_ts = result.visited_ts[inode];
+        if (visited_ts == ts)
+            return;
+        visited_ts = ts;
+        frontier.push_back(inode);
+        std::ranges::push_heap(frontier, later);
+    };
+
+    for (auto inode : result.updated_nodes)
+        visit(inode);
+
+    while (!frontier.empty())
+    {
+        std::ranges::pop_heap(frontier, later);
+        auto inode = frontier.back();
+        frontier.pop_back();
+
+        for (const auto& e : group(instructions->node_edges, inode))
+            transfer_edge(result, e);
+
+        if (!compute_node(result, g, *instructions, inode, stoken, progress))
+            return false;
+
+        // Consumers of a node that has not been recomputed, or has been
+        // recomputed with the same outputs, need no recomputation because
+        // of that node
+        if (result.changed_ts[inode] != ts)
+            continue;
+
+        for (auto consumer : group(instructions->consumers, inode))
+            visit(consumer);
     }
 
+    mark_complete(result, *instructions);
     return true;
 }
 
+auto request_outputs(ComputationResult& result,
+                     const ComputationGraph& g,
+                     const ComputationInstructions* instructions,
+                     std::span<const EdgeOutputEnd> outputs)
+    -> void
+{
+    auto active = std::vector<bool>(g.nodes.size().v, false);
+
+    auto stack = std::vector<NodeIndex>{};
+    for (const auto& output : outputs)
+    {
+        if (!g.nodes.index_range().contains(output.node))
+            mpk::mix::throw_<std::out_of_range>(
+                "Requested output {} refers to a non-existent node", output);
+        stack.push_back(output.node);
+    }
+
+    while (!stack.empty())
+    {
+        auto inode = stack.back();
+        stack.pop_back();
+        if (active[inode.v])
+            continue;
+        active[inode.v] = true;
+        for (auto source : group(instructions->sources, inode))
+            stack.push_back(source);
+    }
+
+    // Nodes becoming active may be outdated, and consumers of nodes
+    // becoming inactive have to be checked, so all nodes are checked
+    // by the next computation; requesting the same outputs again
+    // costs nothing.
+    if (active != result.active_nodes)
+    {
+        result.active_nodes = std::move(active);
+        result.complete_ts = Timestamp{};
+    }
+}
+
+auto request_all_outputs(ComputationResult& result)
+    -> void
+{
+    if (result.active_nodes.empty())
+        return;
+    result.active_nodes.clear();
+    result.complete_ts = Timestamp{};
+}
+
+auto reset_result(ComputationResult& result)
+    -> void
+{
+    std::ranges::fill(result.node_ts, Timestamp{});
+    std::ranges::fill(result.changed_ts, Timestamp{});
+    std::ranges::fill(result.output_fingerprints, 0);
+    std::ranges::fill(result.updated_ts, Timestamp{});
+    std::ranges::fill(result.visited_ts, Timestamp{});
+    std::ranges::fill(result.input_updated_ts, Timestamp{});
+    result.computation_ts = 0;
+    result.complete_ts = 0;
+    result.source_versions.clear();
+    result.updated_inputs.clear();
+    result.updated_nodes.clear();
+    result.frontier.clear();
+}
+
+auto adopt_result(Computation& c,
+                  Computation prev,
+                  std::span<const std::optional<NodeIndex>> prev_nodes)
+    -> void
+{
+    const auto& g = c.graph;
+    const auto& prev_g = prev.graph;
+    if (prev_nodes.size() != g.nodes.size().v)
+        mpk::mix::throw_<std::invalid_argument>(
+            "Node correspondence has {} elements, expected {}",
+            prev_nodes.size(), g.nodes.size().v);
+    for (const auto& prev_node : prev_nodes)
+        if (prev_node && !prev_g.nodes.index_range().contains(*prev_node))
+            mpk::mix::throw_<std::out_of_range>(
+                "Node correspondence refers to an inexistent node {}",
+                *prev_node);
+
+    auto& prev_result = prev.result;
+    if (prev_result.outputs.v.values.empty())
+        return;
+
+    using SourceMap =
+        std::unordered_map<EdgeInputEnd, EdgeOutputEnd, mpk::mix::detail::Hash>;
+    auto sources_of = [](const ComputationGraph& graph)
+    {
+        auto result = SourceMap{};
+        for (const auto& e : graph.edges)
+            result.emplace(e.to, e.from);
+        return result;
+    };
+    auto sources = sources_of(g);
+    auto prev_sources = sources_of(prev_g);
+
+    // A node is adopted if it has the same ports as in the previous graph,
+    // and its inputs are connected to the same outputs of adopted nodes;
+    // nodes are checked in topological order.
+    auto adopted = std::vector<bool>(g.nodes.size().v, false);
+    for (auto inode : c.instr->nodes.values)
+    {
+        auto prev_node = prev_nodes[inode.v];
+        if (!prev_node)
+            continue;
+
+        const auto& node = *g.nodes[inode];
+        const auto& old_node = *prev_g.nodes[*prev_node];
+        if (node.input_count() != old_node.input_count() ||
+            node.output_count() != old_node.output_count())
+            continue;
+
+        auto same_sources = true;
+        for (auto port : mpk::mix::index_range<InputPort>(node.input_count()))
+        {
+            auto it = sources.find({ inode, port });
+            auto prev_it = prev_sources.find({ *prev_node, port });
+            auto connected = it != sources.end();
+            if (connected != (prev_it != prev_sources.end()))
+                same_sources = false;
+            else if (connected)
+            {
+                auto [source, source_port] = it->second;
+                same_sources = same_sources &&
+                               adopted[source.v] &&
+                               prev_nodes[source.v] == prev_it->second.node &&
+                               source_port == prev_it->second.port;
+            }
+        }
+        adopted[inode.v] = same_sources;
+    }
+
+    // Other nodes remain outdated. The result is not complete, so that
+    // `compute_dirty` checks all nodes.
+    auto& result = c.result;
+    allocate_result(result, g);
+    result.computation_ts = prev_result.computation_ts;
+    for (auto inode : g.nodes.index_range())
+    {
+        if (!adopted[inode.v])
+            continue;
+        auto prev_node = *prev_nodes[inode.v];
+        std::ranges::move(group(prev_result.outputs, prev_node),
+                          group(result.outputs, inode).begin());
+        std::ranges::move(group(prev_result.inputs, prev_node),
+                          group(result.inputs, inode).begin());
+        result.node_ts[inode] = prev_result.node_ts[prev_node];
+        result.changed_ts[inode] = prev_result.changed_ts[prev_node];
+        result.output_fingerprints[inode] =
+            prev_result.output_fingerprints[prev_node];
+    }
+
+    // Versioned source inputs having the values adopted nodes have seen
+    // are not set again
+    const auto& source_inputs = c.source_inputs;
+    if (!source_inputs.versions.empty())
+    {
+        auto n = source_inputs.values.size();
+        result.source_versions.assign(n, 0);
+        for (size_t i=0; i<n; ++i)
+        {
+            auto destinations = group(source_inputs.destinations, i);
+            auto seen = std::ranges::all_of(
+                destinations,
+                [&](const EdgeInputEnd& d)
+                {
+                    return adopted[d.node.v] &&
+                           group(result.inputs, d.node)[d.port] ==
+                               source_inputs.values[i];
+                });
+            if (seen)
+                result.source_versions[i] = source_inputs.versions[i];
+        }
+    }
+}
+
 } // namespace gc
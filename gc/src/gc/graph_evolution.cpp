@@ -0,0 +1,91 @@
+/** @file
+ * @brief Evolution of graph state via feedback from node outputs to inputs.
+ *
+ * Copyright (C) 2025-2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "gc/graph_evolution.hpp"
+#include "gc/graph_computation.hpp"
+
+#include "common/compiler_diagnostic.hpp"
+
+#include <utility>
+
+
+namespace gc {
+
+auto make_evolution_feedback(const ComputationGraph& g,
+                             EdgeOutputEnd source,
+                             std::vector<EdgeInputEnd> sinks)
+    -> EvolutionFeedback
+{
+    // Visit nodes reachable from sink nodes
+    auto node_count = g.nodes.size().v;
+    auto consumers = std::vector<std::vector<NodeIndex>>(node_count);
+    for (const auto& e : g.edges)
+        consumers.at(e.from.node.v).push_back(e.to.node);
+
+    auto visited = std::vector<bool>(node_count, false);
+    auto stack = std::vector<NodeIndex>{};
+    for (const auto& sink : sinks)
+        stack.push_back(sink.node);
+    while (!stack.empty())
+    {
+        auto inode = stack.back();
+        stack.pop_back();
+        if (visited.at(inode.v))
+            continue;
+        visited[inode.v] = true;
+        for (auto consumer : consumers[inode.v])
+            stack.push_back(consumer);
+    }
+
+    auto swap_buffers = !sinks.empty() && visited.at(source.node.v);
+    return {
+        .source = source,
+        .sinks = std::move(sinks),
+        .swap_buffers = swap_buffers };
+}
+
+auto set_feedback(ComputationResult& result, const GraphEvolution& evolution)
+    -> void
+{
+    for (const auto& fb : evolution.feedback)
+    {
+        const auto& src_end = fb.source;
+
+        // The output of an outdated source, e.g., one whose computation
+        // has been interrupted, is not valid; sinks keep their values, and
+        // the next computation recomputes the source from them
+        if (result.node_ts[src_end.node] == Timestamp{})
+            continue;
+
+        GCLIB_DIAGNOSTIC_PUSH();
+        GCLIB_DISABLE_DANGLING_REFERENCE();
+        auto& src_val = group(result.outputs, src_end.node)[src_end.port];
+        GCLIB_DIAGNOSTIC_POP();
+
+        // With the early cutoff, the source is not recomputed if its inputs
+        // turn out to be unchanged, so its output must stay valid
+        auto swap_buffers = fb.swap_buffers && !result.fingerprint;
+
+        for (size_t i=0, n=fb.sinks.size(); i<n; ++i)
+        {
+            const auto& dst_end = fb.sinks[i];
+            auto& dst_val = group(result.inputs, dst_end.node)[dst_end.port];
+            if (swap_buffers && i+1 == n)
+                std::swap(dst_val, src_val);
+            else
+                dst_val = src_val;
+            result.updated_inputs.insert(dst_end);
+        }
+    }
+}
+
+auto clear_feedback(ComputationResult& result)
+    -> void
+{ result.updated_inputs.clear(); }
+
+} // namespace gc
@@ -0,0 +1,27 @@
+/** @file
+ * @brief Plan of storage of intermediate node outputs.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "gc/memory_plan.hpp"
+
+#include <ostream>
+
+
+namespace gc {
+
+auto operator<<(std::ostream& s, const MemoryPlan& plan)
+    -> std::ostream&
+{
+    return s
+        << "outputs: " << plan.output_count
+        << ", kept: " << plan.kept_output_count
+        << ", released: " << plan.output_count - plan.kept_output_count
+        << " in " << plan.buffer_count << " buffers"
+        << ", peak live outputs: " << plan.peak_live_outputs;
+}
+
+} // namespace gc
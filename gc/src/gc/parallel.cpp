@@ -0,0 +1,116 @@
+/** @file
+ * @brief Data-parallel helpers for node computations.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "gc/parallel.hpp"
+
+#include "common/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+
+
+namespace gc {
+
+namespace {
+
+// Number of chunks per pool thread, allowing to balance load
+// when chunks take different time
+constexpr size_t chunks_per_thread = 4;
+
+// Minimal change of progress value reported
+constexpr double progress_step = 0.01;
+
+} // anonymous namespace
+
+
+auto shared_thread_pool() -> common::ThreadPool&
+{
+    static auto pool = common::ThreadPool{};
+    return pool;
+}
+
+auto parallel_chunk_count(size_t n, size_t grain) -> size_t
+{
+    if (n == 0)
+        return 0;
+    auto max_count = shared_thread_pool().thread_count() * chunks_per_thread;
+    grain = std::max<size_t>(grain, 1);
+    return std::min((n + grain - 1) / grain, max_count);
+}
+
+auto parallel_chunks(size_t n,
+                     size_t chunk_count,
+                     const ParallelChunkBody& body,
+                     const std::stop_token& stoken,
+                     const NodeProgress& progress)
+    -> bool
+{
+    if (chunk_count == 0)
+        return !stoken.stop_requested();
+
+    auto& pool = shared_thread_pool();
+
+    auto remaining = std::atomic<size_t>{ chunk_count };
+    auto finished = std::atomic<size_t>{};
+    auto failed = std::atomic<bool>{ false };
+    auto mutex = std::mutex{};
+    auto error = std::exception_ptr{};
+    auto last_progress = 0.;
+
+    auto run_chunk = [&](size_t ichunk)
+    {
+        if (!stoken.stop_requested() &&
+            !failed.load(std::memory_order_acquire))
+        {
+            try {
+                body(ichunk,
+                     n * ichunk / chunk_count,
+                     n * (ichunk + 1) / chunk_count);
+
+                auto finished_count =
+                    finished.fetch_add(1, std::memory_order_acq_rel) + 1;
+                if (progress)
+                {
+                    auto lock = std::lock_guard{ mutex };
+                    auto value = double(finished_count) / chunk_count;
+                    if (value - last_progress >= progress_step ||
+                        finished_count == chunk_count)
+                    {
+                        last_progress = value;
+                        progress(value);
+                    }
+                }
+            }
+            catch (...)
+            {
+                auto lock = std::lock_guard{ mutex };
+                if (!error)
+                    error = std::current_exception();
+                failed.store(true, std::memory_order_release);
+            }
+        }
+
+        remaining.fetch_sub(1, std::memory_order_acq_rel);
+    };
+
+    for (size_t ichunk=1; ichunk<chunk_count; ++ichunk)
+        pool.submit([&run_chunk, ichunk]{ run_chunk(ichunk); });
+    run_chunk(0);
+
+    pool.run_until(
+        [&]{ return remaining.load(std::memory_order_acquire) == 0; });
+
+    if (error)
+        std::rethrow_exception(error);
+
+    return !stoken.stop_requested();
+}
+
+} // namespace gc
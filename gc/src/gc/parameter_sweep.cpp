@@ -0,0 +1,139 @@
+/** @file
+ * @brief Computation of one graph for many combinations of source inputs.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "gc/parameter_sweep.hpp"
+
+#include "common/thread_pool.hpp"
+
+#include "mpk/mix/util/throw.hpp"
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+
+
+namespace gc {
+
+namespace {
+
+auto apply_variant(SourceInputs& source_inputs, const SweepVariant& variant)
+    -> void
+{
+    for (const auto& in : variant.inputs)
+    {
+        if (in.index >= source_inputs.values.size())
+            mpk::mix::throw_<std::out_of_range>(
+                "Sweep variant refers to source input {}, but there are "
+                "only {} source inputs",
+                in.index, source_inputs.values.size());
+        source_inputs.values[in.index] = in.value;
+        touch(source_inputs, in.index);
+    }
+}
+
+} // anonymous namespace
+
+
+auto sweep_variants(std::span<const SweepParameter> parameters)
+    -> std::vector<SweepVariant>
+{
+    auto count = size_t{1};
+    for (const auto& p : parameters)
+        count *= p.values.size();
+
+    auto result = std::vector<SweepVariant>(count);
+    for (size_t ivariant=0; ivariant<count; ++ivariant)
+    {
+        auto& inputs = result[ivariant].inputs;
+        inputs.resize(parameters.size());
+
+        // Decompose variant index into parameter value indices
+        auto rest = ivariant;
+        for (auto ip=parameters.size(); ip>0; --ip)
+        {
+            const auto& p = parameters[ip-1];
+            auto n = p.values.size();
+            inputs[ip-1] = { .index = p.index, .value = p.values[rest % n] };
+            rest /= n;
+        }
+    }
+
+    return result;
+}
+
+auto compute_sweep(Computation& c,
+                   std::span<const SweepVariant> variants,
+                   const SweepResultHandler& handle_result,
+                   const std::stop_token& stoken,
+                   common::ThreadPool& pool)
+    -> bool
+{
+    if (variants.empty())
+        return true;
+
+    enable_versions(c.source_inputs);
+    apply_variant(c.source_inputs, variants.front());
+    if (!compute(c, stoken, {}, pool))
+        return false;
+    handle_result(0, c.result);
+
+    auto remaining = std::atomic<size_t>{ variants.size() - 1 };
+    auto failed = std::atomic<bool>{ false };
+    auto mutex = std::mutex{};
+    auto error = std::exception_ptr{};
+
+    const auto& base = c;
+    auto run_variant = [&](size_t ivariant)
+    {
+        if (!failed.load(std::memory_order_acquire))
+        {
+            try {
+                auto result = base.result;
+                result.profile = nullptr;
+                auto source_inputs = base.source_inputs;
+                apply_variant(source_inputs, variants[ivariant]);
+
+                if (compute_dirty(result,
+                                  base.graph,
+                                  base.instr.get(),
+                                  source_inputs,
+                                  stoken,
+                                  {}))
+                {
+                    auto lock = std::lock_guard{ mutex };
+                    handle_result(ivariant, result);
+                }
+                else
+                    failed.store(true, std::memory_order_release);
+            }
+            catch (...)
+            {
+                auto lock = std::lock_guard{ mutex };
+                if (!error)
+                    error = std::current_exception();
+                failed.store(true, std::memory_order_release);
+            }
+        }
+
+        remaining.fetch_sub(1, std::memory_order_acq_rel);
+    };
+
+    for (size_t ivariant=1, n=variants.size(); ivariant<n; ++ivariant)
+        pool.submit([&run_variant, ivariant]{ run_variant(ivariant); });
+
+    pool.run_until(
+        [&]{ return remaining.load(std::memory_order_acquire) == 0; });
+
+    if (error)
+        std::rethrow_exception(error);
+
+    return !failed.load(std::memory_order_acquire);
+}
+
+} // namespace gc
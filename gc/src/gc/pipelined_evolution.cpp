@@ -0,0 +1,312 @@
+/** @file
+ * @brief Evolution executor overlapping consecutive steps.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "gc/pipelined_evolution.hpp"
+
+#include "mpk/mix/util/throw.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace gc {
+
+namespace {
+
+// Outputs of loop nodes of one step consumed by post-processing nodes,
+// or read by the step handler
+struct Frame final
+{
+    size_t step;
+    mpk::mix::value::ValueVec values;
+};
+
+class FrameQueue final
+{
+public:
+    explicit FrameQueue(size_t capacity) :
+        capacity_{ std::max<size_t>(capacity, 1) }
+    {}
+
+    // Blocks while the queue is full; returns false if the queue is closed
+    auto push(Frame frame) -> bool
+    {
+        auto lock = std::unique_lock{ mutex_ };
+        not_full_.wait(
+            lock, [&]{ return closed_ || frames_.size() < capacity_; });
+        if (closed_)
+            return false;
+        frames_.push_back(std::move(frame));
+        not_empty_.notify_one();
+        return true;
+    }
+
+    // Blocks while the queue is empty; returns nothing if the queue
+    // is closed and empty
+    auto pop() -> std::optional<Frame>
+    {
+        auto lock = std::unique_lock{ mutex_ };
+        not_empty_.wait(lock, [&]{ return closed_ || !frames_.empty(); });
+        if (frames_.empty())
+            return std::nullopt;
+        auto result = std::move(frames_.front());
+        frames_.pop_front();
+        not_full_.notify_one();
+        return result;
+    }
+
+    auto close() -> void
+    {
+        auto lock = std::lock_guard{ mutex_ };
+        closed_ = true;
+        not_full_.notify_all();
+        not_empty_.notify_all();
+    }
+
+private:
+    size_t capacity_;
+    std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+    std::deque<Frame> frames_;
+    bool closed_{};
+};
+
+// Marks nodes reachable from `start` along `adjacent`
+auto reachable(const std::vector<std::vector<NodeIndex>>& adjacent,
+               std::vector<NodeIndex> start)
+    -> std::vector<bool>
+{
+    auto result = std::vector<bool>(adjacent.size(), false);
+    while (!start.empty())
+    {
+        auto inode = start.back();
+        start.pop_back();
+        if (result.at(inode.v))
+            continue;
+        result[inode.v] = true;
+        for (auto next : adjacent[inode.v])
+            start.push_back(next);
+    }
+    return result;
+}
+
+auto evolve_sequentially(Computation& c,
+                         const GraphEvolution& evolution,
+                         size_t steps,
+                         const EvolutionStepHandler& handle_step,
+                         const std::stop_token& stoken)
+    -> bool
+{
+    auto ok = true;
+    for (size_t step=1; ok && step<=steps; ++step)
+    {
+        set_feedback(c.result, evolution);
+        ok = compute_dirty(c, stoken, {});
+        if (ok)
+            handle_step(step, c.result);
+    }
+    clear_feedback(c.result);
+    return ok;
+}
+
+} // anonymous namespace
+
+
+auto evolve_pipelined(Computation& c,
+                      const GraphEvolution& evolution,
+                      size_t steps,
+                      size_t queue_capacity,
+                      const EvolutionStepHandler& handle_step,
+                      const std::stop_token& stoken,
+                      std::span<const EdgeOutputEnd> handled_outputs)
+    -> bool
+{
+    const auto& g = c.graph;
+    auto node_count = g.nodes.size().v;
+
+    // Find loop nodes and post-processing nodes
+    auto consumers = std::vector<std::vector<NodeIndex>>(node_count);
+    auto producers = std::vector<std::vector<NodeIndex>>(node_count);
+    for (const auto& e : g.edges)
+    {
+        consumers.at(e.from.node.v).push_back(e.to.node);
+        producers.at(e.to.node.v).push_back(e.from.node);
+    }
+
+    auto sink_nodes = std::vector<NodeIndex>{};
+    auto source_nodes = std::vector<NodeIndex>{};
+    for (const auto& fb : evolution.feedback)
+    {
+        source_nodes.push_back(fb.source.node);
+        for (const auto& sink : fb.sinks)
+            sink_nodes.push_back(sink.node);
+    }
+
+    auto evolving = reachable(consumers, sink_nodes);
+    auto feeding_back = reachable(producers, source_nodes);
+
+    // Nodes not requested (see `request_outputs`) are not computed at all
+    auto requested = c.result.active_nodes;
+    auto is_requested = [&](NodeIndex inode)
+    { return requested.empty() || requested[inode.v]; };
+
+    auto is_loop_node = [&](NodeIndex inode)
+    { return evolving[inode.v] && feeding_back[inode.v]; };
+    auto is_post_node = [&](NodeIndex inode)
+    {
+        return evolving[inode.v] && !feeding_back[inode.v] &&
+               is_requested(inode);
+    };
+
+    auto has_post_nodes = false;
+    for (auto inode : g.nodes.index_range())
+        has_post_nodes = has_post_nodes || is_post_node(inode);
+    if (!has_post_nodes || !std::ranges::all_of(sink_nodes, is_loop_node))
+        return evolve_sequentially(c, evolution, steps, handle_step, stoken);
+
+    // Outputs of loop nodes consumed by post-processing nodes,
+    // or read by the step handler
+    auto frame_outputs = std::vector<EdgeOutputEnd>{};
+    for (const auto& e : g.edges)
+        if (is_loop_node(e.from.node) && is_post_node(e.to.node))
+            frame_outputs.push_back(e.from);
+    for (const auto& output : handled_outputs)
+    {
+        if (!g.nodes.index_range().contains(output.node))
+            mpk::mix::throw_<std::out_of_range>(
+                "Handled output {} refers to a non-existent node", output);
+        if (is_loop_node(output.node))
+            frame_outputs.push_back(output);
+    }
+    std::ranges::sort(frame_outputs);
+    auto [dup_begin, dup_end] = std::ranges::unique(frame_outputs);
+    frame_outputs.erase(dup_begin, dup_end);
+
+    // Post-processing is computed in a copy of the result, and
+    // the loop is computed in `c.result`.
+    auto& loop_result = c.result;
+    if (loop_result.active_nodes.empty())
+        loop_result.active_nodes.assign(node_count, true);
+    auto post_result = loop_result;
+    post_result.updated_inputs.clear();
+    post_result.active_nodes.assign(node_count, false);
+    for (auto inode : g.nodes.index_range())
+        if (is_post_node(inode))
+        {
+            post_result.active_nodes[inode.v] = true;
+            loop_result.active_nodes[inode.v] = false;
+        }
+
+    auto queue = FrameQueue{ queue_capacity };
+    auto post_ok = true;
+    auto post_error = std::exception_ptr{};
+
+    auto post_thread = std::jthread{ [&]
+    {
+        try {
+            while (auto frame = queue.pop())
+            {
+                // Outputs of loop nodes are updated in the computation
+                // about to start, so their consumers are recomputed.
+                auto ts = post_result.computation_ts + 1;
+                for (size_t i=0, n=frame_outputs.size(); i<n; ++i)
+                {
+                    auto [node, port] = frame_outputs[i];
+                    group(post_result.outputs, node)[port] =
+                        std::move(frame->values[i]);
+                    post_result.node_ts[node] = ts;
+                    post_result.changed_ts[node] = ts;
+                }
+
+                if (!compute(post_result, g, c.instr.get(), c.source_inputs,
+                             stoken, {}))
+                {
+                    post_ok = false;
+                    break;
+                }
+                handle_step(frame->step, post_result);
+            }
+        }
+        catch (...)
+        {
+            post_error = std::current_exception();
+            post_ok = false;
+        }
+        queue.close();
+    } };
+
+    auto loop_ok = true;
+    auto loop_error = std::exception_ptr{};
+    try {
+        for (size_t step=1; step<=steps; ++step)
+        {
+            set_feedback(loop_result, evolution);
+            if (!compute_dirty(c, stoken, {}))
+            {
+                loop_ok = false;
+                break;
+            }
+
+            auto frame = Frame{ .step = step };
+            frame.values.reserve(frame_outputs.size());
+            for (auto [node, port] : frame_outputs)
+                frame.values.push_back(group(loop_result.outputs, node)[port]);
+            if (!queue.push(std::move(frame)))
+                break;
+        }
+    }
+    catch (...)
+    {
+        loop_error = std::current_exception();
+        loop_ok = false;
+    }
+    queue.close();
+    post_thread.join();
+
+    clear_feedback(loop_result);
+    loop_result.active_nodes = std::move(requested);
+
+    // Post-processing nodes were inactive in the loop; unless their outputs
+    // are taken below, they are outdated, so all nodes have to be checked
+    // by the next computation
+    if (!(loop_ok && post_ok))
+        loop_result.complete_ts = Timestamp{};
+
+    if (loop_error)
+        std::rethrow_exception(loop_error);
+    if (post_error)
+        std::rethrow_exception(post_error);
+    if (!(loop_ok && post_ok))
+        return false;
+
+    // Take outputs of post-processing nodes; they are up to date
+    // with respect to the last computation of the loop.
+    for (auto inode : g.nodes.index_range())
+        if (is_post_node(inode))
+        {
+            auto src = group(post_result.outputs, inode);
+            auto dst = group(loop_result.outputs, inode);
+            std::ranges::move(src, dst.begin());
+            loop_result.node_ts[inode] = loop_result.computation_ts;
+            loop_result.changed_ts[inode] = loop_result.computation_ts;
+        }
+
+    return true;
+}
+
+} // namespace gc
@@ -0,0 +1,75 @@
+/** @file
+ * @brief Lock-free collection of node progress sampled at a fixed rate.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "gc/progress_aggregator.hpp"
+
+#include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+
+namespace gc {
+
+ProgressAggregator::ProgressAggregator(size_t node_count)
+{ reset(node_count); }
+
+auto ProgressAggregator::reset(size_t node_count) -> void
+{
+    slots_ = std::vector<Slot>(node_count);
+    sampled_.assign(node_count, not_reported);
+}
+
+auto ProgressAggregator::operator()(NodeIndex inode,
+                                    double node_progress) noexcept
+    -> void
+{
+    assert(inode.v < slots_.size());
+    slots_[inode.v].value.store(node_progress, std::memory_order_relaxed);
+}
+
+auto ProgressAggregator::sample(const GraphProgress& progress) -> size_t
+{
+    auto result = size_t{};
+    for (uint32_t i=0, n=slots_.size(); i<n; ++i)
+    {
+        auto value = slots_[i].value.load(std::memory_order_relaxed);
+        if (value == sampled_[i])
+            continue;
+        sampled_[i] = value;
+        progress(NodeIndex{i}, value);
+        ++result;
+    }
+    return result;
+}
+
+
+ProgressReporter::ProgressReporter(ProgressAggregator& aggregator,
+                                   const GraphProgress& progress,
+                                   std::chrono::milliseconds period) :
+    aggregator_{ aggregator },
+    progress_{ progress },
+    thread_{ [this, period](std::stop_token stoken)
+    {
+        auto mutex = std::mutex{};
+        auto wakeup = std::condition_variable_any{};
+        auto lock = std::unique_lock{ mutex };
+        while (!wakeup.wait_for(lock, stoken, period, []{ return false; }) &&
+               !stoken.stop_requested())
+            aggregator_.sample(progress_);
+    } }
+{}
+
+ProgressReporter::~ProgressReporter()
+{
+    thread_.request_stop();
+    thread_.join();
+    aggregator_.sample(progress_);
+}
+
+} // namespace gc
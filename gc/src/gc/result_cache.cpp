@@ -0,0 +1,235 @@
+/** @file
+ * @brief Memoizing cache of node computation results.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "gc/result_cache.hpp"
+#include "gc/computation_node.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+
+namespace gc {
+
+using namespace mpk::mix::value;
+
+class ResultCache::Impl final
+{
+public:
+    Impl(size_t capacity,
+         ValueSize value_size,
+         ValueFingerprint fingerprint) :
+        capacity_{ capacity },
+        value_size_{ std::move(value_size) },
+        value_fingerprint_{ std::move(fingerprint) }
+    {
+        if (!value_size_)
+            value_size_ = [](const Value&) { return sizeof(Value); };
+    }
+
+    auto find(const ComputationNode* node,
+              ConstInputValues inputs,
+              OutputValues outputs)
+        -> bool
+    {
+        auto key = fingerprint(node, inputs);
+
+        auto lock = std::lock_guard{ mutex_ };
+
+        auto [begin, end] = index_.equal_range(key);
+        for (auto it=begin; it!=end; ++it)
+        {
+            auto entry = it->second;
+            if (entry->node.get() != node || !equal(entry->inputs, inputs))
+                continue;
+
+            assert(entry->outputs.size() == outputs.size().v);
+            std::ranges::copy(entry->outputs, outputs.begin());
+            entries_.splice(entries_.begin(), entries_, entry);
+            ++hit_count_;
+            return true;
+        }
+
+        ++miss_count_;
+        return false;
+    }
+
+    auto insert(const ComputationNodePtr& node,
+                ConstInputValues inputs,
+                OutputValues outputs)
+        -> void
+    {
+        auto key = fingerprint(node.get(), inputs);
+        auto entry = Entry{ .node = node, .key = key };
+        entry.inputs.assign(inputs.begin(), inputs.end());
+        entry.outputs.assign(outputs.begin(), outputs.end());
+        for (const auto& v : entry.inputs)
+            entry.size += value_size_(v);
+        for (const auto& v : entry.outputs)
+            entry.size += value_size_(v);
+
+        if (entry.size > capacity_)
+            return;
+
+        auto lock = std::lock_guard{ mutex_ };
+
+        // Computations running concurrently may insert the same entry
+        auto [begin, end] = index_.equal_range(key);
+        for (auto it=begin; it!=end; ++it)
+            if (it->second->node == node && equal(it->second->inputs, inputs))
+                return;
+
+        size_ += entry.size;
+        entries_.push_front(std::move(entry));
+        index_.emplace(key, entries_.begin());
+
+        while (size_ > capacity_)
+            evict_last();
+    }
+
+    auto clear() -> void
+    {
+        auto lock = std::lock_guard{ mutex_ };
+        index_.clear();
+        entries_.clear();
+        size_ = 0;
+    }
+
+    auto capacity() const noexcept -> size_t
+    { return capacity_; }
+
+    auto size() const -> size_t
+    {
+        auto lock = std::lock_guard{ mutex_ };
+        return size_;
+    }
+
+    auto hit_count() const -> size_t
+    {
+        auto lock = std::lock_guard{ mutex_ };
+        return hit_count_;
+    }
+
+    auto miss_count() const -> size_t
+    {
+        auto lock = std::lock_guard{ mutex_ };
+        return miss_count_;
+    }
+
+private:
+    struct Entry final
+    {
+        ComputationNodePtr node;
+        size_t key{};
+        ValueVec inputs;
+        ValueVec outputs;
+        size_t size{};
+    };
+
+    using EntryList = std::list<Entry>;
+
+    size_t capacity_;
+    ValueSize value_size_;
+    ValueFingerprint value_fingerprint_;
+
+    mutable std::mutex mutex_;
+
+    // Most recently used entries go first
+    EntryList entries_;
+
+    std::unordered_multimap<size_t, EntryList::iterator> index_;
+
+    size_t size_{};
+    size_t hit_count_{};
+    size_t miss_count_{};
+
+    // Hashes the node, the types of its inputs, and their values if they
+    // can be hashed. Called without the lock held, since hashing large
+    // values takes time. Entries with equal fingerprints are told apart
+    // by comparing input values.
+    auto fingerprint(const ComputationNode* node,
+                     ConstInputValues inputs) const
+        -> size_t
+    {
+        auto result = Fingerprint{};
+        result.add(node);
+        for (const auto& input : inputs)
+        {
+            result.add(input.type());
+            result.add(value_fingerprint_ ? value_fingerprint_(input) : 0);
+        }
+        return result.value();
+    }
+
+    static auto equal(const ValueVec& cached, ConstInputValues inputs)
+        -> bool
+    {
+        if (cached.size() != inputs.size().v)
+            return false;
+        auto it = cached.begin();
+        for (const auto& input : inputs)
+            if (*it++ != input)
+                return false;
+        return true;
+    }
+
+    auto evict_last() -> void
+    {
+        assert(!entries_.empty());
+        auto entry = std::prev(entries_.end());
+        auto [begin, end] = index_.equal_range(entry->key);
+        auto it = std::find_if(begin, end,
+                               [&](const auto& item)
+                               { return item.second == entry; });
+        assert(it != end);
+        index_.erase(it);
+        size_ -= entry->size;
+        entries_.erase(entry);
+    }
+};
+
+
+ResultCache::ResultCache(size_t capacity,
+                         ValueSize value_size,
+                         ValueFingerprint fingerprint) :
+    impl_{ std::make_unique<Impl>(
+        capacity, std::move(value_size), std::move(fingerprint)) }
+{}
+
+ResultCache::~ResultCache() = default;
+
+auto ResultCache::find(const ComputationNode* node,
+                       ConstInputValues inputs,
+                       OutputValues outputs)
+    -> bool
+{ return impl_->find(node, inputs, outputs); }
+
+auto ResultCache::insert(const ComputationNodePtr& node,
+                         ConstInputValues inputs,
+                         OutputValues outputs)
+    -> void
+{ impl_->insert(node, inputs, outputs); }
+
+auto ResultCache::clear() -> void
+{ impl_->clear(); }
+
+auto ResultCache::capacity() const noexcept -> size_t
+{ return impl_->capacity(); }
+
+auto ResultCache::size() const -> size_t
+{ return impl_->size(); }
+
+auto ResultCache::hit_count() const -> size_t
+{ return impl_->hit_count(); }
+
+auto ResultCache::miss_count() const -> size_t
+{ return impl_->miss_count(); }
+
+} // namespace gc
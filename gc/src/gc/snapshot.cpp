@@ -0,0 +1,599 @@
+/** @file
+ * @brief Binary snapshots of computation state.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "gc/snapshot.hpp"
+
+#include "gc/computation_node.hpp"
+#include "gc/detail/binary_file.hpp"
+#include "gc/value_fingerprint.hpp"
+
+#include "mpk/mix/util/index_range.hpp"
+#include "mpk/mix/util/throw.hpp"
+
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+#include <typeinfo>
+#include <utility>
+
+#include <unistd.h>
+
+
+namespace gc {
+
+namespace fs = std::filesystem;
+
+using detail::write_u64;
+using detail::write_block;
+
+namespace {
+
+// Snapshot file layout. Numbers and blocks are encoded as in the persistent
+// cache files (see `detail/binary_file.hpp`).
+//   magic, format version
+//   evolution step, computation timestamp
+//   graph signature, graph id: size, bytes
+//   node count
+//   for each node:
+//     input count, output count, node_ts, changed_ts, output fingerprint
+//   edge count
+//   for each edge:
+//     output node, output port, input node, input port
+//   numbers of source inputs, node inputs, and node outputs
+//   for each source input, then for each node input, then for each output:
+//     codec name (empty if the value is not saved), header: size, bytes
+//     payload offset and size
+//   payloads, each at an offset that is a multiple of `payload_alignment`
+constexpr uint64_t file_magic = 0x6763736e61707368;
+constexpr uint64_t file_format_version = 2;
+
+// Page size of all common platforms; also a multiple of the alignment
+// of any value, so payloads can be used in place in a mapped file
+constexpr uint64_t payload_alignment = 4096;
+
+using Value = mpk::mix::value::Value;
+using Bytes = SnapshotCodecs::Bytes;
+
+struct EncodedValue final
+{
+    const SnapshotCodecs::Codec* codec{};
+    std::string header;
+    Bytes payload;
+    uint64_t offset{};
+};
+
+// Encodes a value unless it is empty; returns false if there is no codec
+// for the value.
+auto encode(EncodedValue& result,
+            const Value& value,
+            const SnapshotCodecs& codecs)
+    -> bool
+{
+    if (!value.type())
+        return true;
+    result.codec = codecs.find(value.type());
+    if (!result.codec)
+        return false;
+    result.payload = result.codec->encode(value, result.header);
+    return true;
+}
+
+// Hash of C++ types and port names of nodes; tells apart graphs
+// of the same shape made of different nodes
+auto graph_signature(const ComputationGraph& g)
+    -> uint64_t
+{
+    auto fingerprint = Fingerprint{};
+    auto add = [&](std::string_view s)
+    { fingerprint.add(s.size()).add_bytes(s.data(), s.size()); };
+    for (const auto& node : g.nodes)
+    {
+        add(typeid(*node).name());
+        for (auto name : node->input_names())
+            add(name);
+        for (auto name : node->output_names())
+            add(name);
+    }
+    return fingerprint.value();
+}
+
+auto align_offset(uint64_t offset) noexcept
+    -> uint64_t
+{
+    return (offset + payload_alignment - 1) /
+           payload_alignment * payload_alignment;
+}
+
+auto write_snapshot(const fs::path& path,
+                    const ComputationGraph& g,
+                    const mpk::mix::value::ValueVec& source_inputs,
+                    const ComputationResult& result,
+                    uint64_t evolution_step,
+                    const SnapshotCodecs& codecs,
+                    std::string_view graph_id)
+    -> void
+{
+    if (group_count(result.outputs) != g.nodes.size() ||
+        group_count(result.inputs) != g.nodes.size())
+        mpk::mix::throw_<std::invalid_argument>(
+            "Cannot save snapshot {}: the computation has not been started",
+            path.string());
+
+    // Encode values; nodes having values that cannot be encoded
+    // are saved as outdated, with none of their values.
+    auto values = std::vector<EncodedValue>(
+        source_inputs.size() +
+        result.inputs.v.values.size() +
+        result.outputs.v.values.size());
+    auto* value = values.data();
+    for (const auto& source_input : source_inputs)
+        encode(*value++, source_input, codecs);
+
+    auto* input = value;
+    auto* output = input + result.inputs.v.values.size();
+    auto saved = std::vector<bool>(g.nodes.size().v, true);
+    for (auto inode : g.nodes.index_range())
+    {
+        auto* node_input = input;
+        auto* node_output = output;
+        auto ok = true;
+        for (const auto& v : group(result.inputs, inode))
+            ok = encode(*input++, v, codecs) && ok;
+        for (const auto& v : group(result.outputs, inode))
+            ok = encode(*output++, v, codecs) && ok;
+        if (!ok)
+        {
+            saved[inode.v] = false;
+            std::fill(node_input, input, EncodedValue{});
+            std::fill(node_output, output, EncodedValue{});
+        }
+    }
+
+    auto bytes = std::string{};
+    write_u64(bytes, file_magic);
+    write_u64(bytes, file_format_version);
+    write_u64(bytes, evolution_step);
+    write_u64(bytes, result.computation_ts);
+    write_u64(bytes, graph_signature(g));
+    write_block(bytes, graph_id);
+
+    write_u64(bytes, g.nodes.size().v);
+    for (auto inode : g.nodes.index_range())
+    {
+        const auto& node = *g.nodes[inode];
+        auto node_saved = saved[inode.v];
+        write_u64(bytes, node.input_count().v);
+        write_u64(bytes, node.output_count().v);
+        write_u64(bytes, node_saved ? result.node_ts[inode] : 0);
+        write_u64(bytes, node_saved ? result.changed_ts[inode] : 0);
+        write_u64(bytes,
+                  node_saved && !result.output_fingerprints.empty()
+                      ? result.output_fingerprints[inode] : 0);
+    }
+
+    write_u64(bytes, g.edges.size());
+    for (const auto& e : g.edges)
+    {
+        write_u64(bytes, e.from.node.v);
+        write_u64(bytes, e.from.port.v);
+        write_u64(bytes, e.to.node.v);
+        write_u64(bytes, e.to.port.v);
+    }
+
+    write_u64(bytes, source_inputs.size());
+    write_u64(bytes, result.inputs.v.values.size());
+    write_u64(bytes, result.outputs.v.values.size());
+
+    // Payload offsets are only known once the size of the table is known,
+    // so they are written last
+    auto offset_positions = std::vector<size_t>{};
+    offset_positions.reserve(values.size());
+    for (const auto& v : values)
+    {
+        write_block(bytes, v.codec ? std::string_view{ v.codec->name } : "");
+        write_block(bytes, v.header);
+        offset_positions.push_back(bytes.size());
+        write_u64(bytes, 0);
+        write_u64(bytes, v.payload.size());
+    }
+
+    auto offset = align_offset(bytes.size());
+    for (size_t i=0, n=values.size(); i<n; ++i)
+    {
+        auto& v = values[i];
+        if (v.payload.empty())
+            continue;
+        v.offset = offset;
+        std::memcpy(bytes.data() + offset_positions[i],
+                    &offset, sizeof(offset));
+        offset = align_offset(offset + v.payload.size());
+    }
+
+    // Write a temporary file first, so that the previous snapshot
+    // is replaced only by a complete one. Payloads are written directly
+    // from values.
+    auto tmp_path = path;
+    tmp_path += std::format(".{}.tmp", ::getpid());
+    {
+        auto s = std::ofstream(tmp_path, std::ios::binary);
+        s.write(bytes.data(), bytes.size());
+        auto pos = uint64_t{ bytes.size() };
+        static constexpr auto padding = std::array<char, payload_alignment>{};
+        for (const auto& v : values)
+        {
+            if (v.payload.empty())
+                continue;
+            s.write(padding.data(), v.offset - pos);
+            s.write(reinterpret_cast<const char*>(v.payload.data()),
+                    v.payload.size());
+            pos = v.offset + v.payload.size();
+        }
+        if (!s)
+            mpk::mix::throw_("Failed to write snapshot file {}",
+                             tmp_path.string());
+    }
+    fs::rename(tmp_path, path);
+}
+
+} // anonymous namespace
+
+
+SnapshotCodecs::SnapshotCodecs()
+{
+    add_codec(trivial_codec<bool>("bool"));
+    add_codec(trivial_codec<int8_t>("i8"));
+    add_codec(trivial_codec<uint8_t>("u8"));
+    add_codec(trivial_codec<int16_t>("i16"));
+    add_codec(trivial_codec<uint16_t>("u16"));
+    add_codec(trivial_codec<int32_t>("i32"));
+    add_codec(trivial_codec<uint32_t>("u32"));
+    add_codec(trivial_codec<int64_t>("i64"));
+    add_codec(trivial_codec<uint64_t>("u64"));
+    add_codec(trivial_codec<float>("f32"));
+    add_codec(trivial_codec<double>("f64"));
+    add_codec(trivial_codec<std::vector<int8_t>>("i8[]"));
+    add_codec(trivial_codec<std::vector<uint8_t>>("u8[]"));
+    add_codec(trivial_codec<std::vector<int16_t>>("i16[]"));
+    add_codec(trivial_codec<std::vector<uint16_t>>("u16[]"));
+    add_codec(trivial_codec<std::vector<int32_t>>("i32[]"));
+    add_codec(trivial_codec<std::vector<uint32_t>>("u32[]"));
+    add_codec(trivial_codec<std::vector<int64_t>>("i64[]"));
+    add_codec(trivial_codec<std::vector<uint64_t>>("u64[]"));
+    add_codec(trivial_codec<std::vector<float>>("f32[]"));
+    add_codec(trivial_codec<std::vector<double>>("f64[]"));
+    add_codec({
+        .name = "str",
+        .type = mpk::mix::value::type_of<std::string>(),
+        .encode = [](const Value& value, std::string&) -> Bytes
+        { return std::as_bytes(std::span{ value.as<std::string>() }); },
+        .decode = [](Bytes, Bytes payload) -> Value
+        {
+            return std::string(
+                reinterpret_cast<const char*>(payload.data()),
+                payload.size());
+        } });
+}
+
+auto SnapshotCodecs::add_codec(Codec codec) -> void
+{
+    if (codec_by_name_.contains(codec.name))
+        mpk::mix::throw_<std::invalid_argument>(
+            "SnapshotCodecs: codec '{}' is already registered", codec.name);
+    if (codec.name.empty())
+        mpk::mix::throw_<std::invalid_argument>(
+            "SnapshotCodecs: codec name must not be empty");
+
+    auto index = codecs_.size();
+    codec_by_name_[codec.name] = index;
+    codec_by_type_[codec.type] = index;
+    codecs_.push_back(std::move(codec));
+}
+
+auto SnapshotCodecs::find(const mpk::mix::value::Type* type) const
+    -> const Codec*
+{
+    auto it = codec_by_type_.find(type);
+    return it == codec_by_type_.end() ? nullptr : &codecs_[it->second];
+}
+
+auto SnapshotCodecs::find(std::string_view name) const
+    -> const Codec*
+{
+    auto it = codec_by_name_.find(std::string{ name });
+    return it == codec_by_name_.end() ? nullptr : &codecs_[it->second];
+}
+
+
+auto take_snapshot(const ComputationGraph& g,
+                   const SourceInputs& source_inputs,
+                   const ComputationResult& result,
+                   uint64_t evolution_step,
+                   std::string_view graph_id)
+    -> ComputationSnapshot
+{
+    auto snapshot = ComputationSnapshot{
+        .graph = g,
+        .source_inputs = source_inputs.values,
+        .evolution_step = evolution_step,
+        .graph_id = std::string{ graph_id } };
+    auto& r = snapshot.result;
+    r.inputs = result.inputs;
+    r.outputs = result.outputs;
+    r.node_ts = result.node_ts;
+    r.changed_ts = result.changed_ts;
+    r.output_fingerprints = result.output_fingerprints;
+    r.computation_ts = result.computation_ts;
+    return snapshot;
+}
+
+auto save_snapshot(const fs::path& path,
+                   const ComputationGraph& g,
+                   const SourceInputs& source_inputs,
+                   const ComputationResult& result,
+                   uint64_t evolution_step,
+                   const SnapshotCodecs& codecs,
+                   std::string_view graph_id)
+    -> void
+{
+    write_snapshot(path, g, source_inputs.values, result,
+                   evolution_step, codecs, graph_id);
+}
+
+auto save_snapshot(const fs::path& path,
+                   const ComputationSnapshot& snapshot,
+                   const SnapshotCodecs& codecs)
+    -> void
+{
+    write_snapshot(path,
+                   snapshot.graph,
+                   snapshot.source_inputs,
+                   snapshot.result,
+                   snapshot.evolution_step,
+                   codecs,
+                   snapshot.graph_id);
+}
+
+auto restore_snapshot(Computation& c,
+                      const fs::path& path,
+                      const SnapshotCodecs& codecs,
+                      std::string_view graph_id)
+    -> uint64_t
+{
+    auto file = detail::MappedFile{ path };
+    if (!file)
+        mpk::mix::throw_("Failed to open snapshot file {}", path.string());
+    file.advise_sequential();
+
+    auto bytes = file.bytes();
+    auto r = detail::FileReader{ bytes };
+    auto check = [&](bool ok)
+    {
+        if (!ok)
+            mpk::mix::throw_<std::invalid_argument>(
+                "File {} is not a valid computation snapshot",
+                path.string());
+    };
+
+    check(r.u64() == file_magic &&
+          r.u64() == file_format_version &&
+          r);
+
+    const auto& g = c.graph;
+    auto prev = Computation{ .graph = { .nodes = g.nodes } };
+    auto& prev_result = prev.result;
+
+    auto evolution_step = r.u64();
+    prev_result.computation_ts = r.u64();
+    auto signature = r.u64();
+    auto saved_graph_id = r.str();
+
+    auto node_count = r.u64();
+    check(bool(r));
+    if (node_count != g.nodes.size().v)
+        mpk::mix::throw_<SnapshotMismatch>(
+            "Snapshot {} has {} nodes, expected {}",
+            path.string(), node_count, g.nodes.size().v);
+    if (signature != graph_signature(g))
+        mpk::mix::throw_<SnapshotMismatch>(
+            "Snapshot {} is one of a graph with other nodes",
+            path.string());
+    if (saved_graph_id != graph_id)
+        mpk::mix::throw_<SnapshotMismatch>(
+            "Snapshot {} is one of another graph", path.string());
+
+    prev_result.node_ts =
+        mpk::mix::StrongVector<Timestamp, NodeIndex>(g.nodes.size(), 0);
+    prev_result.changed_ts =
+        mpk::mix::StrongVector<Timestamp, NodeIndex>(g.nodes.size(), 0);
+    prev_result.output_fingerprints =
+        mpk::mix::StrongVector<uint64_t, NodeIndex>(g.nodes.size(), 0);
+    for (auto inode : g.nodes.index_range())
+    {
+        const auto& node = *g.nodes[inode];
+        auto input_count = r.u64();
+        auto output_count = r.u64();
+        prev_result.node_ts[inode] = r.u64();
+        prev_result.changed_ts[inode] = r.u64();
+        prev_result.output_fingerprints[inode] = r.u64();
+        check(bool(r));
+        if (input_count != node.input_count().v ||
+            output_count != node.output_count().v)
+            mpk::mix::throw_<SnapshotMismatch>(
+                "Snapshot {}: node {} has {} inputs and {} outputs, "
+                "expected {} and {}",
+                path.string(), inode,
+                input_count, output_count,
+                node.input_count().v, node.output_count().v);
+
+        for (auto _ : mpk::mix::index_range<InputPort>(node.input_count()))
+            mpk::mix::add_to_last_group(prev_result.inputs, Value{});
+        mpk::mix::next_group(prev_result.inputs);
+        for (auto _ : mpk::mix::index_range<OutputPort>(node.output_count()))
+            mpk::mix::add_to_last_group(prev_result.outputs, Value{});
+        mpk::mix::next_group(prev_result.outputs);
+    }
+
+    auto edge_count = r.u64();
+    check(edge_count <= bytes.size());
+    prev.graph.edges.reserve(edge_count);
+    for (uint64_t i=0; i<edge_count; ++i)
+    {
+        auto from_node = r.u64();
+        auto from_port = r.u64();
+        auto to_node = r.u64();
+        auto to_port = r.u64();
+        check(r &&
+              from_node < node_count &&
+              to_node < node_count);
+        auto from = NodeIndex{ static_cast<WeakNodeIndex>(from_node) };
+        auto to = NodeIndex{ static_cast<WeakNodeIndex>(to_node) };
+        check(from_port < g.nodes[from]->output_count().v &&
+              to_port < g.nodes[to]->input_count().v);
+        prev.graph.edges.push_back(
+            edge({ from, OutputPort{ static_cast<WeakPort>(from_port) } },
+                 { to, InputPort{ static_cast<WeakPort>(to_port) } }));
+    }
+
+    auto source_count = r.u64();
+    auto input_count = r.u64();
+    auto output_count = r.u64();
+    check(r &&
+          input_count == prev_result.inputs.v.values.size() &&
+          output_count == prev_result.outputs.v.values.size());
+    if (source_count != c.source_inputs.values.size())
+        mpk::mix::throw_<SnapshotMismatch>(
+            "Snapshot {} has {} source inputs, expected {}",
+            path.string(), source_count, c.source_inputs.values.size());
+
+    // Returns false if the value is not saved
+    auto read_value = [&](Value& value) -> bool
+    {
+        auto name = r.str();
+        auto header = r.block();
+        auto offset = r.u64();
+        auto size = r.u64();
+        check(r && offset <= bytes.size() && size <= bytes.size() - offset);
+        if (name.empty())
+            return false;
+
+        const auto* codec = codecs.find(name);
+        if (!codec)
+            mpk::mix::throw_<std::invalid_argument>(
+                "Snapshot {} contains a value encoded by unknown codec '{}'",
+                path.string(), name);
+        value = codec->decode(header, bytes.subspan(offset, size));
+        return true;
+    };
+
+    auto source_values = mpk::mix::value::ValueVec(source_count);
+    auto saved_sources = std::vector<bool>(source_count);
+    for (size_t i=0; i<source_count; ++i)
+    {
+        saved_sources[i] = read_value(source_values[i]);
+        const auto* type = c.source_inputs.values[i].type();
+        if (saved_sources[i] && type && source_values[i].type() != type)
+            mpk::mix::throw_<SnapshotMismatch>(
+                "Snapshot {}: source input {} has another type",
+                path.string(), i);
+    }
+    for (auto& value : prev_result.inputs.v.values)
+        read_value(value);
+    for (auto& value : prev_result.outputs.v.values)
+        read_value(value);
+
+    // Everything is read, so the computation can be modified
+    for (size_t i=0; i<source_count; ++i)
+    {
+        if (!saved_sources[i])
+            continue;
+        c.source_inputs.values[i] = std::move(source_values[i]);
+        touch(c.source_inputs, i);
+    }
+
+    auto prev_nodes = std::vector<std::optional<NodeIndex>>{};
+    prev_nodes.reserve(node_count);
+    for (auto inode : g.nodes.index_range())
+        prev_nodes.push_back(inode);
+    adopt_result(c, std::move(prev), prev_nodes);
+
+    return evolution_step;
+}
+
+
+SnapshotWriter::SnapshotWriter(fs::path path, SnapshotCodecs codecs) :
+    path_{ std::move(path) },
+    codecs_{ std::move(codecs) },
+    thread_{ [this](std::stop_token stoken)
+    {
+        auto lock = std::unique_lock{ mutex_ };
+        while (wakeup_.wait(lock, stoken, [&]{ return pending_.has_value(); }))
+        {
+            auto snapshot = std::move(*pending_);
+            pending_.reset();
+            writing_ = true;
+            lock.unlock();
+
+            auto error = std::string{};
+            try
+            {
+                save_snapshot(path_, snapshot, codecs_);
+            }
+            catch (std::exception& e)
+            {
+                error = e.what();
+            }
+
+            lock.lock();
+            writing_ = false;
+            error_ = std::move(error);
+            if (error_.empty())
+                ++saved_count_;
+            wakeup_.notify_all();
+        }
+    } }
+{}
+
+SnapshotWriter::~SnapshotWriter()
+{
+    flush();
+    thread_.request_stop();
+    thread_.join();
+}
+
+auto SnapshotWriter::save(ComputationSnapshot snapshot) -> void
+{
+    auto lock = std::lock_guard{ mutex_ };
+    pending_ = std::move(snapshot);
+    wakeup_.notify_all();
+}
+
+auto SnapshotWriter::flush() -> void
+{
+    auto lock = std::unique_lock{ mutex_ };
+    wakeup_.wait(lock, [&]{ return !pending_ && !writing_; });
+}
+
+auto SnapshotWriter::path() const noexcept -> const fs::path&
+{ return path_; }
+
+auto SnapshotWriter::saved_count() const -> size_t
+{
+    auto lock = std::lock_guard{ mutex_ };
+    return saved_count_;
+}
+
+auto SnapshotWriter::error() const -> std::string
+{
+    auto lock = std::lock_guard{ mutex_ };
+    return error_;
+}
+
+} // namespace gc
@@ -10,8 +10,38 @@
 
 #include "gc/source_inputs.hpp"
 
+#include <atomic>
+#include <cassert>
+
 namespace gc {
 
+auto new_source_input_version() noexcept -> SourceInputVersion
+{
+    static auto next_version = std::atomic<SourceInputVersion>{ 1 };
+    return next_version.fetch_add(1, std::memory_order_relaxed);
+}
+
+auto enable_versions(SourceInputs& source_inputs) -> void
+{
+    auto& versions = source_inputs.versions;
+    if (!versions.empty())
+        return;
+
+    versions.resize(source_inputs.values.size());
+    for (auto& version : versions)
+        version = new_source_input_version();
+}
+
+auto touch(SourceInputs& source_inputs, size_t index) -> void
+{
+    auto& versions = source_inputs.versions;
+    if (versions.empty())
+        return;
+
+    assert(versions.size() == source_inputs.values.size());
+    versions.at(index) = new_source_input_version();
+}
+
 auto operator<<(std::ostream& s, const SourceInputs& source_inputs)
     -> std::ostream&
 {
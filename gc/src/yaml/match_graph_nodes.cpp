@@ -0,0 +1,53 @@
+/** @file
+ * @brief Matching of nodes of two versions of a graph file.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "gc/yaml/match_graph_nodes.hpp"
+
+#include <yaml-cpp/yaml.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+
+namespace gc::yaml {
+
+auto match_graph_nodes(const YAML::Node& config,
+                       const YAML::Node& prev_config)
+    -> std::vector<std::optional<NodeIndex>>
+{
+    struct PrevNode final
+    {
+        NodeIndex index;
+        std::string definition;
+    };
+
+    auto prev_nodes = std::unordered_map<std::string, PrevNode>{};
+    if (prev_config)
+    {
+        auto index = uint32_t{};
+        for (const auto& node : prev_config["nodes"])
+            prev_nodes.emplace(
+                node["name"].as<std::string>(),
+                PrevNode{ .index = NodeIndex{ index++ },
+                          .definition = YAML::Dump(node) });
+    }
+
+    auto result = std::vector<std::optional<NodeIndex>>{};
+    for (const auto& node : config["nodes"])
+    {
+        auto it = prev_nodes.find(node["name"].as<std::string>());
+        if (it != prev_nodes.end() && it->second.definition == YAML::Dump(node))
+            result.push_back(it->second.index);
+        else
+            result.push_back(std::nullopt);
+    }
+    return result;
+}
+
+} // namespace gc::yaml
@@ -0,0 +1,49 @@
+/** @file
+ * @brief Parsing of the `evolution` section of a graph file.
+ *
+ * Copyright (C) 2025-2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "gc/yaml/parse_graph_evolution.hpp"
+
+#include "gc/computation_node.hpp"
+#include "gc/detail/computation_node_indices.hpp"
+#include "gc/detail/parse_node_port.hpp"
+
+#include <yaml-cpp/yaml.h>
+
+
+namespace gc::yaml {
+
+auto parse_graph_evolution(
+    const YAML::Node& config,
+    const ComputationGraph& graph,
+    const detail::NamedNodes<ComputationNode>& node_map)
+    -> GraphEvolution
+{
+    auto node_indices = detail::ComputationNodeIndices{};
+    for (auto inode : graph.nodes.index_range())
+        node_indices.emplace(graph.nodes[inode].get(), inode);
+
+    auto result = GraphEvolution{};
+    for (const auto& feedback_item : config["feedback"])
+    {
+        auto source = detail::parse_node_port(
+            feedback_item["source"].as<std::string>(),
+            node_map, node_indices, Output);
+
+        auto sinks = std::vector<EdgeInputEnd>{};
+        for (const auto& sink : feedback_item["sink"])
+            sinks.push_back(detail::parse_node_port(
+                sink.as<std::string>(), node_map, node_indices, Input));
+
+        result.feedback.push_back(
+            make_evolution_feedback(graph, source, std::move(sinks)));
+    }
+
+    return result;
+}
+
+} // namespace gc::yaml
@@ -0,0 +1,104 @@
+/** @file
+ * @brief Tests of the persistent result cache.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "gc/disk_cache.hpp"
+
+#include "build/scratch_dir.hpp"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+
+using ValueVec = mpk::mix::value::ValueVec;
+
+TEST(Gc_DiskCache, FindInserted)
+{
+    auto scratch_dir = build::ScratchDir{};
+    auto inputs = ValueVec{ uint32_t{10}, std::string{"abc"} };
+    auto outputs = ValueVec{ std::vector<uint32_t>{ 1, 2, 3 }, 1.5 };
+
+    {
+        auto cache = gc::DiskCache{ scratch_dir.path(), 1 << 20 };
+        auto found = ValueVec(2);
+        EXPECT_FALSE(cache.find("node", inputs, found));
+        cache.insert("node", inputs, outputs);
+        EXPECT_GT(cache.size(), 0);
+
+        EXPECT_TRUE(cache.find("node", inputs, found));
+        EXPECT_EQ(found, outputs);
+
+        EXPECT_FALSE(cache.find("other_node", inputs, found));
+        auto other_inputs = ValueVec{ uint32_t{11}, std::string{"abc"} };
+        EXPECT_FALSE(cache.find("node", other_inputs, found));
+
+        EXPECT_EQ(cache.hit_count(), 1);
+        EXPECT_EQ(cache.miss_count(), 3);
+    }
+
+    // Cache files persist
+    auto cache = gc::DiskCache{ scratch_dir.path(), 1 << 20 };
+    auto found = ValueVec(2);
+    EXPECT_TRUE(cache.find("node", inputs, found));
+    EXPECT_EQ(found, outputs);
+}
+
+TEST(Gc_DiskCache, Evict)
+{
+    auto scratch_dir = build::ScratchDir{};
+    auto outputs = ValueVec{ std::vector<uint32_t>(100) };
+
+    // Each file takes about 500 bytes
+    auto cache = gc::DiskCache{ scratch_dir.path(), 1000 };
+    for (uint32_t i=0; i<3; ++i)
+        cache.insert("node", ValueVec{ i }, outputs);
+    EXPECT_LE(cache.size(), 1000);
+
+    auto found = ValueVec(1);
+    EXPECT_FALSE(cache.find("node", ValueVec{ uint32_t{0} }, found));
+    EXPECT_TRUE(cache.find("node", ValueVec{ uint32_t{2} }, found));
+
+    // Entries larger than the capacity are not stored
+    cache.insert("node",
+                 ValueVec{ uint32_t{3} },
+                 ValueVec{ std::vector<uint32_t>(1000) });
+    EXPECT_FALSE(cache.find("node", ValueVec{ uint32_t{3} }, found));
+}
+
+TEST(Gc_DiskCache, InsertIsBestEffort)
+{
+    auto scratch_dir = build::ScratchDir{};
+    auto dir = scratch_dir.path() / "cache";
+    auto inputs = ValueVec{ uint32_t{10} };
+    auto outputs = ValueVec{ 1.5 };
+
+    // Failures to write cache files are not errors
+    auto cache = gc::DiskCache{ dir, 1 << 20 };
+    std::filesystem::remove_all(dir);
+    EXPECT_NO_THROW(cache.insert("node", inputs, outputs));
+    EXPECT_EQ(cache.size(), 0);
+    auto found = ValueVec(1);
+    EXPECT_FALSE(cache.find("node", inputs, found));
+
+    // Threads may insert the same entry concurrently
+    std::filesystem::create_directories(dir);
+    {
+        auto threads = std::vector<std::jthread>{};
+        for (auto i=0; i<4; ++i)
+            threads.emplace_back([&]{ cache.insert("node", inputs, outputs); });
+    }
+    EXPECT_TRUE(cache.find("node", inputs, found));
+    EXPECT_EQ(found, outputs);
+    auto file_count = std::ranges::distance(
+        std::filesystem::directory_iterator{ dir },
+        std::filesystem::directory_iterator{});
+    EXPECT_EQ(file_count, 1);
+}
@@ -10,17 +10,36 @@
 
 #include "gc/graph_computation.hpp"
 #include "gc/computation_node.hpp"
+#include "gc/computation_profile.hpp"
+#include "gc/graph_evolution.hpp"
 #include "gc/node_port_names.hpp"
+#include "gc/parameter_sweep.hpp"
+#include "gc/pipelined_evolution.hpp"
+#include "gc/progress_aggregator.hpp"
+#include "gc/result_cache.hpp"
+#include "gc/snapshot.hpp"
+
+#include "build/scratch_dir.hpp"
+#include "common/thread_pool.hpp"
 
 #include "mpk/mix/util/format_streamable.hpp"
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <format>
+#include <fstream>
 
 #include <initializer_list>
 #include <numeric>
+#include <optional>
 #include <ranges>
+#include <span>
+#include <sstream>
+#include <thread>
+#include <utility>
 
 
 using namespace std::literals;
@@ -83,11 +102,132 @@ public:
     { return computation_count_; }
 
 private:
-    mutable size_t computation_count_{};
+    mutable std::atomic<size_t> computation_count_{};
     gc::DynamicInputNames input_names_;
     gc::DynamicOutputNames output_names_;
 };
 
+// Adds 10 to its input; the input is transformed in place if the output
+// is the input value itself
+class InPlaceTestNode final
+    : public gc::ComputationNode
+{
+public:
+    auto input_names() const
+        -> gc::InputNames override
+    { return gc::node_input_names<InPlaceTestNode>("input"sv); }
+
+    auto output_names() const
+        -> gc::OutputNames override
+    { return gc::node_output_names<InPlaceTestNode>("output"sv); }
+
+    auto default_inputs(gc::InputValues result) const
+        -> void override
+    { result[0_gc_i] = 0; }
+
+    auto compute_outputs(gc::OutputValues result,
+                         gc::ConstInputValues inputs,
+                         const std::stop_token&,
+                         const gc::NodeProgress&) const
+        -> bool override
+    {
+        if (&result[0_gc_o] == &inputs[0_gc_i])
+            ++in_place_count_;
+        else
+            result[0_gc_o] = inputs[0_gc_i];
+        result[0_gc_o].as<int>() += 10;
+        return true;
+    }
+
+    auto in_place_ports() const
+        -> std::optional<gc::InPlacePorts> override
+    { return gc::InPlacePorts{ .input = 0_gc_i, .output = 0_gc_o }; }
+
+    auto in_place_count() const noexcept
+        -> size_t
+    { return in_place_count_; }
+
+private:
+    mutable std::atomic<size_t> in_place_count_{};
+};
+
+// Outputs its input plus the number of its previous computations, so its
+// outputs are not determined by its input, like those of random generators
+class CounterNode final
+    : public gc::ComputationNode
+{
+public:
+    explicit CounterNode(bool cacheable) :
+        cacheable_{ cacheable }
+    {}
+
+    auto input_names() const
+        -> gc::InputNames override
+    { return gc::node_input_names<CounterNode>("input"sv); }
+
+    auto output_names() const
+        -> gc::OutputNames override
+    { return gc::node_output_names<CounterNode>("output"sv); }
+
+    auto default_inputs(gc::InputValues result) const
+        -> void override
+    { result[0_gc_i] = 0; }
+
+    auto compute_outputs(gc::OutputValues result,
+                         gc::ConstInputValues inputs,
+                         const std::stop_token&,
+                         const gc::NodeProgress&) const
+        -> bool override
+    {
+        result[0_gc_o] = inputs[0_gc_i].as<int>() +
+                         static_cast<int>(computation_count_++);
+        return true;
+    }
+
+    auto cacheable() const
+        -> bool override
+    { return cacheable_; }
+
+private:
+    bool cacheable_;
+    mutable std::atomic<size_t> computation_count_{};
+};
+
+// Outputs the sum of its inputs. When stop is requested, the output
+// is left partially overwritten, as by a node stopped in the middle of
+// a frame computed into its output buffer.
+class InterruptibleTestNode final
+    : public gc::ComputationNode
+{
+public:
+    auto input_names() const
+        -> gc::InputNames override
+    { return gc::node_input_names<InterruptibleTestNode>("a"sv, "b"sv); }
+
+    auto output_names() const
+        -> gc::OutputNames override
+    { return gc::node_output_names<InterruptibleTestNode>("sum"sv); }
+
+    auto default_inputs(gc::InputValues result) const
+        -> void override
+    { std::fill(result.begin(), result.end(), 0); }
+
+    auto compute_outputs(gc::OutputValues result,
+                         gc::ConstInputValues inputs,
+                         const std::stop_token& stoken,
+                         const gc::NodeProgress&) const
+        -> bool override
+    {
+        if (stoken.stop_requested())
+        {
+            result[0_gc_o] = -1;
+            return false;
+        }
+        result[0_gc_o] = inputs[0_gc_i].as<int>() + inputs[1_gc_i].as<int>();
+        return true;
+    }
+};
+
 struct TestGraphNodeSpec
 {
     gc::WeakPort input_count{};
@@ -350,6 +490,42 @@ TEST(Gc, compute_1)
     EXPECT_EQ(group(result.outputs, 1_gc_n)[0_gc_o].as<int>(), 2);
 }
 
+TEST(Gc, compute_binds_edges)
+{
+    // [0] -> 0 -> 1
+    auto g = test_graph(
+        {{1, 1}, {1, 1}},
+        {edge({0,0}, {1,0})});
+
+    auto [instr, source_inputs] = compile(g);
+
+    auto result = gc::ComputationResult{};
+    compute(result, g, instr.get(), source_inputs);
+    EXPECT_EQ(group(result.outputs, 1_gc_n)[0_gc_o].as<int>(), 2);
+
+    // Input of node 1 is bound to the output of node 0 rather than copied
+    EXPECT_EQ(group(result.input_refs, 1_gc_n)[0_gc_i],
+              &group(result.outputs, 0_gc_n)[0_gc_o]);
+
+    // Source input is bound to its own storage
+    EXPECT_EQ(group(result.input_refs, 0_gc_n)[0_gc_i],
+              &group(result.inputs, 0_gc_n)[0_gc_i]);
+
+    // Manually updated input is bound to its own storage too
+    group(result.inputs, 1_gc_n)[0_gc_i] = 10;
+    result.updated_inputs.insert({1_gc_n, 0_gc_i});
+    compute(result, g, instr.get(), source_inputs);
+    EXPECT_EQ(group(result.outputs, 1_gc_n)[0_gc_o].as<int>(), 11);
+
+    // A copy of the result is rebound to its own data
+    result.updated_inputs.clear();
+    ++source_inputs.values[0].as<int>();
+    auto result_copy = result;
+    compute(result_copy, g, instr.get(), source_inputs);
+    EXPECT_EQ(group(result_copy.outputs, 1_gc_n)[0_gc_o].as<int>(), 3);
+    EXPECT_EQ(group(result.outputs, 1_gc_n)[0_gc_o].as<int>(), 11);
+}
+
 TEST(Gc, compute_2)
 {
     // 8 -> 7 -> 5
@@ -434,6 +610,40 @@ TEST(Gc, compute_3)
     EXPECT_EQ(group(result.outputs, 1_gc_n)[0_gc_o].as<int>(), 444);
 }
 
+TEST(Gc, compute_updated_inputs)
+{
+    // [0]
+    //  |
+    //  0 -> 1
+    auto g = test_graph({{1, 1}, {1, 1}}, {edge({0,0}, {1,0})});
+    auto [instr, source_inputs] = compile(g);
+
+    auto result = gc::ComputationResult{};
+    compute(result, g, instr.get(), source_inputs);
+
+    // Updated inputs are validated once per computation,
+    // rather than looked up for each edge
+    result.updated_inputs.insert({1_gc_n, 1_gc_i});
+    EXPECT_THROW(compute(result, g, instr.get(), source_inputs),
+                 std::out_of_range);
+
+    result.updated_inputs = {{2_gc_n, 0_gc_i}};
+    EXPECT_THROW(compute(result, g, instr.get(), source_inputs),
+                 std::out_of_range);
+
+    // Inputs updated by a previous computation are bound
+    // to upstream outputs again
+    result.updated_inputs = {{1_gc_n, 0_gc_i}};
+    group(result.inputs, 1_gc_n)[0_gc_i] = 10;
+    compute(result, g, instr.get(), source_inputs);
+    EXPECT_EQ(group(result.outputs, 1_gc_n)[0_gc_o].as<int>(), 11);
+
+    result.updated_inputs.clear();
+    result.node_ts[1_gc_n] = gc::Timestamp{};
+    compute(result, g, instr.get(), source_inputs);
+    EXPECT_EQ(group(result.outputs, 1_gc_n)[0_gc_o].as<int>(), 2);
+}
+
 TEST(Gc, compute_partially)
 {
     auto format_result = [](const gc::ComputationResult& res,
@@ -519,3 +729,1155 @@ TEST(Gc, compute_partially)
 4: (3) - ts: 4, computed: 2
 )");
 }
+
+TEST(Gc, compute_dataflow)
+{
+    // 8 -> 7 -> 5
+    //
+    // |    |    |
+    // v    v    v
+    //
+    // 6 -> 4 -> 2
+    //
+    // |    |    |
+    // v    v    v
+    //
+    // 3 -> 1 -> 0
+    auto g = test_graph_net_3x3();
+
+    auto [instr, source_inputs] = gc::compile(g);
+
+    auto format_result = [](const gc::ComputationResult& res)
+        -> std::string
+    {
+        std::ostringstream s;
+        for (auto inode=0_gc_n; inode<9_gc_n; ++inode)
+        {
+            auto gr = group(res.outputs, inode);
+            auto seq = std::ranges::transform_view(
+                gr,
+                [](const mpk::mix::value::Value& v)
+                { return v.as<int>(); });
+            s << inode << ": (" << mpk::mix::format_seq(seq)
+              << ") - ts: " << res.node_ts.at(inode) << std::endl;
+        }
+        return s.str();
+    };
+
+    auto expected = gc::ComputationResult{};
+    compute(expected, g, instr.get(), source_inputs);
+
+    auto pool = common::ThreadPool{ 4 };
+    auto result = gc::ComputationResult{};
+    EXPECT_TRUE(
+        compute(result, g, instr.get(), source_inputs, {}, {}, pool));
+    EXPECT_EQ(format_result(result), format_result(expected));
+
+    // Nothing is recomputed when no inputs change
+    for (const auto& node : g.nodes)
+        EXPECT_EQ(
+            static_cast<const TestNode*>(node.get())->computation_count(), 2);
+    EXPECT_TRUE(
+        compute(result, g, instr.get(), source_inputs, {}, {}, pool));
+    for (const auto& node : g.nodes)
+        EXPECT_EQ(
+            static_cast<const TestNode*>(node.get())->computation_count(), 2);
+    EXPECT_EQ(result.complete_ts, result.computation_ts);
+
+    // Computations of an empty graph are complete too
+    auto empty = gc::ComputationGraph{};
+    auto [empty_instr, empty_inputs] = gc::compile(empty);
+    auto empty_result = gc::ComputationResult{};
+    EXPECT_TRUE(compute(empty_result, empty, empty_instr.get(),
+                        empty_inputs, {}, {}, pool));
+    EXPECT_EQ(empty_result.complete_ts, empty_result.computation_ts);
+}
+
+TEST(Gc, compute_dirty)
+{
+    auto computation_counts = [](const gc::ComputationGraph& g)
+    {
+        auto result = std::vector<size_t>{};
+        for (const auto& node : g.nodes)
+            result.push_back(
+                static_cast<const TestNode*>(node.get())->computation_count());
+        return result;
+    };
+
+    // [0]  [1]
+    //  |    |
+    //  0    1
+    //  |    |
+    //  +--. +--.
+    //  |  | |  |
+    //  v  v v  v
+    //  2   3   4
+    //      |
+    //      v
+    //      5
+    auto g = test_graph({{1, 1}, {1, 1},
+                         {1, 1}, {2, 1}, {1, 1},
+                         {1, 1}},
+                        {edge({0,0}, {2,0}),
+                         edge({0,0}, {3,0}),
+                         edge({1,0}, {3,1}),
+                         edge({1,0}, {4,0}),
+                         edge({3,0}, {5,0})});
+
+    auto [instr, source_inputs] = gc::compile(g);
+
+    auto result = gc::ComputationResult{};
+
+    // First computation visits all nodes
+    EXPECT_TRUE(compute_dirty(result, g, instr.get(), source_inputs, {}, {}));
+    EXPECT_EQ(computation_counts(g), (std::vector<size_t>{1, 1, 1, 1, 1, 1}));
+    EXPECT_EQ(group(result.outputs, 5_gc_n)[0_gc_o].as<int>(), 4);
+
+    // Update input [1]; nodes 0 and 2 are not reachable
+    ++source_inputs.values[1].as<int>();
+    EXPECT_TRUE(compute_dirty(result, g, instr.get(), source_inputs, {}, {}));
+    EXPECT_EQ(computation_counts(g), (std::vector<size_t>{1, 2, 1, 2, 2, 2}));
+    EXPECT_EQ(group(result.outputs, 5_gc_n)[0_gc_o].as<int>(), 5);
+    EXPECT_NE(result.visited_ts[0_gc_n], result.computation_ts);
+    EXPECT_NE(result.visited_ts[2_gc_n], result.computation_ts);
+
+    // Nothing changed - nothing is visited
+    EXPECT_TRUE(compute_dirty(result, g, instr.get(), source_inputs, {}, {}));
+    EXPECT_EQ(computation_counts(g), (std::vector<size_t>{1, 2, 1, 2, 2, 2}));
+    for (auto inode : g.nodes.index_range())
+        EXPECT_NE(result.visited_ts[inode], result.computation_ts);
+
+    // Manually update input of node 3
+    group(result.inputs, 3_gc_n)[0_gc_i] = 10;
+    result.updated_inputs.insert({3_gc_n, 0_gc_i});
+    EXPECT_TRUE(compute_dirty(result, g, instr.get(), source_inputs, {}, {}));
+    result.updated_inputs.clear();
+    EXPECT_EQ(computation_counts(g), (std::vector<size_t>{1, 2, 1, 3, 2, 3}));
+    EXPECT_EQ(group(result.outputs, 5_gc_n)[0_gc_o].as<int>(), 14);
+}
+
+TEST(Gc, request_outputs)
+{
+    auto computation_counts = [](const gc::ComputationGraph& g)
+    {
+        auto result = std::vector<size_t>{};
+        for (const auto& node : g.nodes)
+            result.push_back(
+                static_cast<const TestNode*>(node.get())->computation_count());
+        return result;
+    };
+
+    // Same graph as in the `compute_dirty` test
+    auto g = test_graph({{1, 1}, {1, 1},
+                         {1, 1}, {2, 1}, {1, 1},
+                         {1, 1}},
+                        {edge({0,0}, {2,0}),
+                         edge({0,0}, {3,0}),
+                         edge({1,0}, {3,1}),
+                         edge({1,0}, {4,0}),
+                         edge({3,0}, {5,0})});
+
+    auto c = gc::computation(g, {});
+    EXPECT_TRUE(compute_dirty(c, {}, {}));
+    EXPECT_EQ(computation_counts(g), (std::vector<size_t>{1, 1, 1, 1, 1, 1}));
+
+    // Only nodes 0 and 2 are upstream of the output of node 2
+    auto output_2 = gc::EdgeOutputEnd{2_gc_n, 0_gc_o};
+    request_outputs(c, std::span{ &output_2, 1 });
+    ++c.source_inputs.values[0].as<int>();
+    ++c.source_inputs.values[1].as<int>();
+    EXPECT_TRUE(compute_dirty(c, {}, {}));
+    EXPECT_EQ(computation_counts(g), (std::vector<size_t>{2, 1, 2, 1, 1, 1}));
+    EXPECT_EQ(group(c.result.outputs, 2_gc_n)[0_gc_o].as<int>(), 3);
+    EXPECT_EQ(group(c.result.outputs, 5_gc_n)[0_gc_o].as<int>(), 4);
+
+    // The result is complete for the active nodes, so the next computation
+    // only visits updated nodes, unless the requested outputs change
+    EXPECT_EQ(c.result.complete_ts, c.result.computation_ts);
+    request_outputs(c, std::span{ &output_2, 1 });
+    EXPECT_EQ(c.result.complete_ts, c.result.computation_ts);
+    ++c.source_inputs.values[0].as<int>();
+    EXPECT_TRUE(compute_dirty(c, {}, {}));
+    EXPECT_EQ(computation_counts(g), (std::vector<size_t>{3, 1, 3, 1, 1, 1}));
+    EXPECT_EQ(c.result.visited_ts[0_gc_n], c.result.computation_ts);
+    EXPECT_NE(c.result.visited_ts[1_gc_n], c.result.computation_ts);
+    EXPECT_EQ(group(c.result.outputs, 2_gc_n)[0_gc_o].as<int>(), 4);
+
+    // Node 1 has missed the update of its input, and is computed now
+    auto output_5 = gc::EdgeOutputEnd{5_gc_n, 0_gc_o};
+    request_outputs(c, std::span{ &output_5, 1 });
+    EXPECT_TRUE(compute_dirty(c, {}, {}));
+    EXPECT_EQ(computation_counts(g), (std::vector<size_t>{3, 2, 3, 2, 1, 2}));
+    EXPECT_EQ(group(c.result.outputs, 5_gc_n)[0_gc_o].as<int>(), 7);
+
+    gc::request_all_outputs(c.result);
+    EXPECT_TRUE(compute_dirty(c, {}, {}));
+    EXPECT_EQ(computation_counts(g), (std::vector<size_t>{3, 2, 3, 2, 2, 2}));
+    EXPECT_EQ(group(c.result.outputs, 4_gc_n)[0_gc_o].as<int>(), 3);
+}
+
+TEST(Gc, early_cutoff)
+{
+    auto computation_counts = [](const gc::ComputationGraph& g)
+    {
+        auto result = std::vector<size_t>{};
+        for (const auto& node : g.nodes)
+            result.push_back(
+                static_cast<const TestNode*>(node.get())->computation_count());
+        return result;
+    };
+
+    // [0] [1]
+    //  |   |
+    //  v   v
+    //    0
+    //    |
+    //    v
+    //    1
+    auto g = test_graph({{2, 1}, {1, 1}}, {edge({0,0}, {1,0})});
+
+    for (auto dirty : { false, true })
+    {
+        auto c = gc::computation(g, {});
+        c.result.fingerprint = [](const mpk::mix::value::Value& value)
+        { return gc::Fingerprint{}.add(value.as<int>()).value(); };
+        auto counts = computation_counts(g);
+        auto compute_and_count = [&]
+        {
+            EXPECT_TRUE(dirty ? compute_dirty(c, {}, {}) : compute(c, {}, {}));
+            auto prev_counts = std::exchange(counts, computation_counts(g));
+            return std::vector<size_t>{ counts[0] - prev_counts[0],
+                                        counts[1] - prev_counts[1] };
+        };
+
+        EXPECT_EQ(compute_and_count(), (std::vector<size_t>{1, 1}));
+
+        // The sum of inputs of node 0 does not change, nor does its output
+        ++c.source_inputs.values[0].as<int>();
+        --c.source_inputs.values[1].as<int>();
+        EXPECT_EQ(compute_and_count(), (std::vector<size_t>{1, 0}));
+        EXPECT_EQ(group(c.result.outputs, 1_gc_n)[0_gc_o].as<int>(), 2);
+
+        // Node 1 is not recomputed later either
+        EXPECT_EQ(compute_and_count(), (std::vector<size_t>{0, 0}));
+
+        ++c.source_inputs.values[0].as<int>();
+        EXPECT_EQ(compute_and_count(), (std::vector<size_t>{1, 1}));
+        EXPECT_EQ(group(c.result.outputs, 1_gc_n)[0_gc_o].as<int>(), 3);
+    }
+}
+
+TEST(Gc, memory_plan)
+{
+    auto computation_counts = [](const gc::ComputationGraph& g)
+    {
+        auto result = std::vector<size_t>{};
+        for (const auto& node : g.nodes)
+            result.push_back(
+                static_cast<const TestNode*>(node.get())->computation_count());
+        return result;
+    };
+
+    // [0]
+    //  |
+    //  0 -> 1 -> 2 -> 3
+    auto g = test_graph({{1, 1}, {1, 1}, {1, 1}, {1, 1}},
+                        {edge({0,0}, {1,0}),
+                         edge({1,0}, {2,0}),
+                         edge({2,0}, {3,0})});
+
+    auto [instr, source_inputs] = gc::compile(
+        g, {}, { .keep_outputs = { { 1_gc_n, 0_gc_o } },
+                 .plan_memory = true });
+
+    // Output of node 0 dies after level 1, so node 2 reuses its buffer;
+    // outputs of nodes 1 and 3 are kept
+    const auto* plan = gc::memory_plan(*instr);
+    ASSERT_NE(plan, nullptr);
+    EXPECT_EQ(plan->output_count, 4);
+    EXPECT_EQ(plan->kept_output_count, 2);
+    EXPECT_EQ(plan->buffer_count, 1);
+    EXPECT_EQ(plan->peak_live_outputs, 3);
+    EXPECT_EQ(group(plan->buffers, 1_gc_n)[0_gc_o], gc::MemoryPlan::no_buffer);
+    EXPECT_EQ(group(plan->buffers, 0_gc_n)[0_gc_o],
+              group(plan->buffers, 2_gc_n)[0_gc_o]);
+    EXPECT_EQ(gc::memory_plan(*gc::compile(g).first), nullptr);
+
+    auto pool = common::ThreadPool{ 2 };
+    for (auto dataflow : { false, true })
+    {
+        auto result = gc::ComputationResult{};
+        result.fingerprint = [](const mpk::mix::value::Value& value)
+        { return gc::Fingerprint{}.add(value.as<int>()).value(); };
+        auto prev_counts = computation_counts(g);
+        auto compute_and_count = [&]
+        {
+            EXPECT_TRUE(
+                dataflow
+                    ? compute(result, g, instr.get(), source_inputs,
+                              {}, {}, pool)
+                    : compute(result, g, instr.get(), source_inputs,
+                              {}, {}));
+            auto counts = computation_counts(g);
+            auto delta = std::vector<size_t>{};
+            for (size_t i=0; i<counts.size(); ++i)
+                delta.push_back(counts[i] - prev_counts[i]);
+            prev_counts = counts;
+            return delta;
+        };
+
+        EXPECT_EQ(compute_and_count(), (std::vector<size_t>{1, 1, 1, 1}));
+        EXPECT_EQ(group(result.outputs, 3_gc_n)[0_gc_o].as<int>(), 4);
+        EXPECT_EQ(group(result.outputs, 1_gc_n)[0_gc_o].as<int>(), 2);
+        EXPECT_FALSE(group(result.outputs, 0_gc_n)[0_gc_o].type());
+        EXPECT_FALSE(group(result.outputs, 2_gc_n)[0_gc_o].type());
+        ASSERT_EQ(result.spare_buffers.size(), 1);
+        EXPECT_TRUE(result.spare_buffers[0].type());
+
+        // Nodes with released outputs are recomputed; their consumers are
+        // not, due to early cutoff. Computations are never complete, so
+        // `compute_dirty` would check all nodes as well.
+        EXPECT_EQ(compute_and_count(), (std::vector<size_t>{1, 0, 1, 0}));
+        EXPECT_NE(result.complete_ts, result.computation_ts);
+        EXPECT_EQ(group(result.outputs, 3_gc_n)[0_gc_o].as<int>(), 4);
+    }
+}
+
+TEST(Gc, compute_in_place)
+{
+    // 0 -> 1 -> 2, node 1 adds 10 in place
+    auto in_place_node = std::make_shared<InPlaceTestNode>();
+    auto g = gc::ComputationGraph{
+        .nodes = { std::make_shared<TestNode>(0, 1),
+                   in_place_node,
+                   std::make_shared<TestNode>(1, 1) },
+        .edges = { edge({0,0}, {1,0}), edge({1,0}, {2,0}) } };
+
+    auto output = [](const gc::Computation& c, gc::NodeIndex inode)
+        -> const mpk::mix::value::Value&
+    { return group(c.result.outputs, inode)[0_gc_o]; };
+    auto computation_count = [&](gc::NodeIndex inode)
+    {
+        return static_cast<const TestNode*>(
+            g.nodes[inode].get())->computation_count();
+    };
+
+    // Node 1 takes over the output of node 0, which is then recomputed
+    // by each computation
+    auto c = gc::computation(g, {}, { .compute_in_place = true });
+    auto pool = common::ThreadPool{ 2 };
+    for (auto dataflow : { false, true, false })
+    {
+        EXPECT_TRUE(dataflow ? compute(c, {}, {}, pool)
+                             : compute_dirty(c, {}, {}));
+        EXPECT_FALSE(output(c, 0_gc_n).type());
+        EXPECT_EQ(output(c, 1_gc_n).as<int>(), 11);
+        EXPECT_EQ(output(c, 2_gc_n).as<int>(), 12);
+        EXPECT_NE(c.result.complete_ts, c.result.computation_ts);
+    }
+    EXPECT_EQ(in_place_node->in_place_count(), 3);
+    EXPECT_EQ(computation_count(0_gc_n), 3);
+
+    // Kept outputs are not taken over
+    auto kept = gc::computation(
+        g, {}, { .keep_outputs = { { 0_gc_n, 0_gc_o } },
+                 .compute_in_place = true });
+    EXPECT_TRUE(compute_dirty(kept, {}, {}));
+    EXPECT_EQ(output(kept, 0_gc_n).as<int>(), 1);
+    EXPECT_EQ(output(kept, 1_gc_n).as<int>(), 11);
+
+    // Neither are outputs having other consumers
+    g.nodes.push_back(std::make_shared<TestNode>(1, 1));
+    g.edges.push_back(edge({0,0}, {3,0}));
+    auto shared = gc::computation(g, {}, { .compute_in_place = true });
+    EXPECT_TRUE(compute_dirty(shared, {}, {}));
+    EXPECT_EQ(output(shared, 0_gc_n).as<int>(), 1);
+    EXPECT_EQ(output(shared, 1_gc_n).as<int>(), 11);
+    EXPECT_EQ(output(shared, 3_gc_n).as<int>(), 2);
+    EXPECT_EQ(shared.result.complete_ts, shared.result.computation_ts);
+
+    EXPECT_EQ(in_place_node->in_place_count(), 3);
+}
+
+TEST(Gc, adopt_result)
+{
+    auto computation_counts = [](const gc::ComputationGraph& g)
+    {
+        auto result = std::vector<size_t>{};
+        for (const auto& node : g.nodes)
+            result.push_back(
+                static_cast<const TestNode*>(node.get())->computation_count());
+        return result;
+    };
+
+    // [0]      [1]
+    //  |        |
+    //  0 -> 1   2
+    auto prev = gc::computation(
+        test_graph({{1, 1}, {1, 1}, {1, 1}}, {edge({0,0}, {1,0})}), {});
+    gc::enable_versions(prev.source_inputs);
+    EXPECT_TRUE(compute_dirty(prev, {}, {}));
+
+    // Node 2 is rewired, and node 3 is added
+    // [0]
+    //  |
+    //  0 -> 1 -> 3
+    //  |
+    //  +--> 2
+    auto c = gc::computation(
+        test_graph({{1, 1}, {1, 1}, {1, 1}, {1, 1}},
+                   {edge({0,0}, {1,0}),
+                    edge({0,0}, {2,0}),
+                    edge({1,0}, {3,0})}),
+        {});
+    gc::enable_versions(c.source_inputs);
+    auto prev_nodes =
+        std::vector<std::optional<gc::NodeIndex>>{ 0_gc_n, 1_gc_n, 2_gc_n, {} };
+    gc::adopt_result(c, std::move(prev), prev_nodes);
+
+    EXPECT_TRUE(compute_dirty(c, {}, {}));
+    EXPECT_EQ(computation_counts(c.graph), (std::vector<size_t>{0, 0, 1, 1}));
+    EXPECT_EQ(group(c.result.outputs, 1_gc_n)[0_gc_o].as<int>(), 2);
+    EXPECT_EQ(group(c.result.outputs, 2_gc_n)[0_gc_o].as<int>(), 2);
+    EXPECT_EQ(group(c.result.outputs, 3_gc_n)[0_gc_o].as<int>(), 3);
+
+    // Adopted nodes are recomputed when their inputs change
+    ++c.source_inputs.values[0].as<int>();
+    gc::touch(c.source_inputs, 0);
+    EXPECT_TRUE(compute_dirty(c, {}, {}));
+    EXPECT_EQ(computation_counts(c.graph), (std::vector<size_t>{1, 1, 2, 2}));
+    EXPECT_EQ(group(c.result.outputs, 3_gc_n)[0_gc_o].as<int>(), 4);
+
+    EXPECT_THROW(
+        gc::adopt_result(c, {}, std::span{ prev_nodes }.first(2)),
+        std::invalid_argument);
+    EXPECT_THROW(gc::adopt_result(c, {}, prev_nodes), std::out_of_range);
+}
+
+TEST(Gc, snapshot)
+{
+    auto computation_counts = [](const gc::ComputationGraph& g)
+    {
+        auto result = std::vector<size_t>{};
+        for (const auto& node : g.nodes)
+            result.push_back(
+                static_cast<const TestNode*>(node.get())->computation_count());
+        return result;
+    };
+
+    // [0]      [1]
+    //  |        |
+    //  0 -> 1   2
+    auto make_computation = []
+    {
+        auto c = gc::computation(
+            test_graph({{1, 1}, {1, 1}, {1, 1}}, {edge({0,0}, {1,0})}), {});
+        gc::enable_versions(c.source_inputs);
+        return c;
+    };
+
+    auto scratch_dir = build::ScratchDir{};
+    auto path = scratch_dir.path() / "state.gcs";
+    auto codecs = gc::SnapshotCodecs{};
+
+    auto c = make_computation();
+    c.source_inputs.values[0] = 5;
+    gc::touch(c.source_inputs, 0);
+    EXPECT_TRUE(compute_dirty(c, {}, {}));
+    gc::save_snapshot(path, c, 42, codecs);
+
+    // Restored nodes are not recomputed
+    auto restored = make_computation();
+    EXPECT_EQ(gc::restore_snapshot(restored, path, codecs), 42u);
+    EXPECT_EQ(restored.source_inputs.values[0].as<int>(), 5);
+    EXPECT_EQ(restored.result.computation_ts, c.result.computation_ts);
+    EXPECT_EQ(restored.result.outputs.v.values, c.result.outputs.v.values);
+    EXPECT_TRUE(compute_dirty(restored, {}, {}));
+    EXPECT_EQ(computation_counts(restored.graph),
+              (std::vector<size_t>{0, 0, 0}));
+    EXPECT_EQ(group(restored.result.outputs, 1_gc_n)[0_gc_o].as<int>(), 7);
+
+    // Restored nodes are recomputed when their inputs change
+    restored.source_inputs.values[0] = 6;
+    gc::touch(restored.source_inputs, 0);
+    EXPECT_TRUE(compute_dirty(restored, {}, {}));
+    EXPECT_EQ(computation_counts(restored.graph),
+              (std::vector<size_t>{1, 1, 0}));
+    EXPECT_EQ(group(restored.result.outputs, 1_gc_n)[0_gc_o].as<int>(), 8);
+
+    // Snapshots are written in the background; the computation
+    // can change meanwhile
+    {
+        auto writer = gc::SnapshotWriter{ path, codecs };
+        writer.save(gc::take_snapshot(restored, 43));
+        restored.source_inputs.values[0] = 7;
+        gc::touch(restored.source_inputs, 0);
+        EXPECT_TRUE(compute_dirty(restored, {}, {}));
+        writer.flush();
+        EXPECT_EQ(writer.saved_count(), 1u);
+        EXPECT_EQ(writer.error(), "");
+    }
+    auto restored_again = make_computation();
+    EXPECT_EQ(gc::restore_snapshot(restored_again, path, codecs), 43u);
+    EXPECT_EQ(restored_again.source_inputs.values[0].as<int>(), 6);
+    EXPECT_EQ(
+        group(restored_again.result.outputs, 1_gc_n)[0_gc_o].as<int>(), 8);
+
+    // Snapshots of other graphs are rejected
+    auto other = gc::computation(test_graph({{1, 1}, {1, 1}}, {}), {});
+    EXPECT_THROW(gc::restore_snapshot(other, path, codecs),
+                 gc::SnapshotMismatch);
+    auto other_ports = gc::computation(
+        test_graph({{1, 1}, {1, 2}, {1, 1}}, {edge({0,0}, {1,0})}), {});
+    EXPECT_THROW(gc::restore_snapshot(other_ports, path, codecs),
+                 gc::SnapshotMismatch);
+    auto other_sources = make_computation();
+    other_sources.source_inputs.values[0] = 1.5;
+    EXPECT_THROW(gc::restore_snapshot(other_sources, path, codecs),
+                 gc::SnapshotMismatch);
+    EXPECT_THROW(gc::restore_snapshot(restored_again, path, codecs, "other"),
+                 gc::SnapshotMismatch);
+
+    // Graph ids are compared
+    gc::save_snapshot(path, c, 44, codecs, "graph");
+    auto restored_by_id = make_computation();
+    EXPECT_THROW(gc::restore_snapshot(restored_by_id, path, codecs),
+                 gc::SnapshotMismatch);
+    EXPECT_EQ(gc::restore_snapshot(restored_by_id, path, codecs, "graph"),
+              44u);
+
+    // Files that are not snapshots are errors, not mismatches
+    {
+        auto s = std::ofstream(path, std::ios::binary);
+        s << "not a snapshot";
+    }
+    try
+    {
+        gc::restore_snapshot(restored_by_id, path, codecs, "graph");
+        ADD_FAILURE() << "Expected std::invalid_argument";
+    }
+    catch (const gc::SnapshotMismatch&)
+    { ADD_FAILURE() << "Unexpected gc::SnapshotMismatch"; }
+    catch (const std::invalid_argument&)
+    {}
+    EXPECT_ANY_THROW(
+        gc::restore_snapshot(other, scratch_dir.path() / "missing", codecs));
+}
+
+TEST(Gc, source_input_versions)
+{
+    auto computation_counts = [](const gc::ComputationGraph& g)
+    {
+        auto result = std::vector<size_t>{};
+        for (const auto& node : g.nodes)
+            result.push_back(
+                static_cast<const TestNode*>(node.get())->computation_count());
+        return result;
+    };
+
+    // [0]  [1]
+    //  |    |
+    //  0    1
+    //  |    |
+    //  v    v
+    //  2    3
+    auto g = test_graph({{1, 1}, {1, 1}, {1, 1}, {1, 1}},
+                        {edge({0,0}, {2,0}),
+                         edge({1,0}, {3,0})});
+
+    auto [instr, source_inputs] = gc::compile(g);
+    gc::enable_versions(source_inputs);
+    ASSERT_EQ(source_inputs.versions.size(), source_inputs.values.size());
+
+    auto result = gc::ComputationResult{};
+    EXPECT_TRUE(compute_dirty(result, g, instr.get(), source_inputs, {}, {}));
+    EXPECT_EQ(computation_counts(g), (std::vector<size_t>{1, 1, 1, 1}));
+
+    // Values modified without touching are not noticed
+    ++source_inputs.values[0].as<int>();
+    EXPECT_TRUE(compute_dirty(result, g, instr.get(), source_inputs, {}, {}));
+    EXPECT_EQ(computation_counts(g), (std::vector<size_t>{1, 1, 1, 1}));
+
+    // Touched inputs are set even though values are not modified
+    gc::touch(source_inputs, 1);
+    EXPECT_TRUE(compute_dirty(result, g, instr.get(), source_inputs, {}, {}));
+    EXPECT_EQ(computation_counts(g), (std::vector<size_t>{1, 2, 1, 2}));
+
+    gc::touch(source_inputs, 0);
+    EXPECT_TRUE(compute_dirty(result, g, instr.get(), source_inputs, {}, {}));
+    EXPECT_EQ(computation_counts(g), (std::vector<size_t>{2, 2, 2, 2}));
+    EXPECT_EQ(group(result.outputs, 2_gc_n)[0_gc_o].as<int>(), 3);
+    EXPECT_EQ(group(result.outputs, 3_gc_n)[0_gc_o].as<int>(), 2);
+}
+
+TEST(Gc, compute_result_cache)
+{
+    auto computation_counts = [](const gc::ComputationGraph& g)
+    {
+        auto result = std::vector<size_t>{};
+        for (const auto& node : g.nodes)
+            result.push_back(
+                static_cast<const TestNode*>(node.get())->computation_count());
+        return result;
+    };
+
+    // [0]
+    //  |
+    //  0 --> 1
+    auto g = test_graph({{1, 1}, {1, 1}},
+                        {edge({0,0}, {1,0})});
+
+    auto [instr, source_inputs] = gc::compile(g);
+
+    auto result = gc::ComputationResult{};
+    result.cache = std::make_shared<gc::ResultCache>(1000);
+
+    compute(result, g, instr.get(), source_inputs);
+    EXPECT_EQ(computation_counts(g), (std::vector<size_t>{1, 1}));
+    EXPECT_EQ(result.cache->miss_count(), 2);
+    EXPECT_EQ(result.cache->size(), 4 * sizeof(mpk::mix::value::Value));
+
+    source_inputs.values[0] = 1;
+    compute(result, g, instr.get(), source_inputs);
+    EXPECT_EQ(computation_counts(g), (std::vector<size_t>{2, 2}));
+    EXPECT_EQ(group(result.outputs, 1_gc_n)[0_gc_o].as<int>(), 3);
+
+    // Inputs seen before - outputs are taken from the cache
+    source_inputs.values[0] = 0;
+    compute(result, g, instr.get(), source_inputs);
+    EXPECT_EQ(computation_counts(g), (std::vector<size_t>{2, 2}));
+    EXPECT_EQ(group(result.outputs, 1_gc_n)[0_gc_o].as<int>(), 2);
+    EXPECT_EQ(result.cache->hit_count(), 2);
+    EXPECT_EQ(result.cache->miss_count(), 4);
+
+    // Least recently used entries are evicted
+    auto small_cache =
+        std::make_shared<gc::ResultCache>(2 * sizeof(mpk::mix::value::Value));
+    result.cache = small_cache;
+    source_inputs.values[0] = 5;
+    compute(result, g, instr.get(), source_inputs);
+    EXPECT_EQ(small_cache->size(), 2 * sizeof(mpk::mix::value::Value));
+    source_inputs.values[0] = 0;
+    compute(result, g, instr.get(), source_inputs);
+    EXPECT_EQ(computation_counts(g), (std::vector<size_t>{4, 4}));
+    EXPECT_EQ(small_cache->hit_count(), 0);
+
+    // Input values are hashed to look entries up
+    auto hashed_count = size_t{};
+    result.cache = std::make_shared<gc::ResultCache>(
+        1000,
+        gc::ResultCache::ValueSize{},
+        [&](const mpk::mix::value::Value& value) -> uint64_t
+        {
+            ++hashed_count;
+            return gc::Fingerprint{}.add(value.as<int>()).value();
+        });
+    for (auto input : {7, 8, 7})
+    {
+        source_inputs.values[0] = input;
+        compute(result, g, instr.get(), source_inputs);
+    }
+    EXPECT_EQ(computation_counts(g), (std::vector<size_t>{6, 6}));
+    EXPECT_EQ(result.cache->hit_count(), 2);
+    EXPECT_EQ(group(result.outputs, 1_gc_n)[0_gc_o].as<int>(), 9);
+    EXPECT_GT(hashed_count, 0u);
+}
+
+TEST(Gc, result_cache_bypass)
+{
+    // [0]  [0]
+    //  |    |
+    //  0    1
+    //
+    // Node 0 is not cacheable, node 1 is
+    auto g = gc::ComputationGraph{};
+    g.nodes.emplace_back(std::make_shared<CounterNode>(false));
+    g.nodes.emplace_back(std::make_shared<CounterNode>(true));
+
+    auto [instr, source_inputs] = gc::compile(g);
+
+    auto result = gc::ComputationResult{};
+    result.cache = std::make_shared<gc::ResultCache>(1000);
+    auto output = [&](gc::NodeIndex inode)
+    { return group(result.outputs, inode)[0_gc_o].as<int>(); };
+
+    compute(result, g, instr.get(), source_inputs);
+    EXPECT_EQ(output(0_gc_n), 0);
+    EXPECT_EQ(output(1_gc_n), 0);
+
+    // Inputs seen before - only outputs of node 1 are taken from the cache
+    for (auto input : {1, 0})
+    {
+        source_inputs.values[0] = input;
+        source_inputs.values[1] = input;
+        compute(result, g, instr.get(), source_inputs);
+    }
+    EXPECT_EQ(output(0_gc_n), 2);
+    EXPECT_EQ(output(1_gc_n), 0);
+
+    // Nodes having inputs updated manually are recomputed, even though
+    // the cache has outputs for their inputs
+    result.updated_inputs.insert({1_gc_n, 0_gc_i});
+    compute(result, g, instr.get(), source_inputs);
+    result.updated_inputs.clear();
+    EXPECT_EQ(output(0_gc_n), 2);
+    EXPECT_EQ(output(1_gc_n), 2);
+
+    // So are outdated nodes
+    gc::reset_result(result);
+    compute(result, g, instr.get(), source_inputs);
+    EXPECT_EQ(output(0_gc_n), 3);
+    EXPECT_EQ(output(1_gc_n), 3);
+}
+
+TEST(Gc, compute_profile)
+{
+    // [0]  [1]
+    //  |    |
+    //  0    1
+    //  |    |
+    //  v    v
+    //  2 <--+
+    auto g = test_graph({{1, 1}, {1, 1}, {2, 1}},
+                        {edge({0,0}, {2,0}),
+                         edge({1,0}, {2,1})});
+
+    auto [instr, source_inputs] = gc::compile(g);
+
+    auto result = gc::ComputationResult{};
+    result.profile = std::make_shared<gc::ComputationProfile>();
+
+    compute(result, g, instr.get(), source_inputs);
+    source_inputs.values[0] = 1;
+    compute(result, g, instr.get(), source_inputs);
+
+    const auto& nodes = result.profile->nodes;
+    ASSERT_EQ(nodes.size(), g.nodes.size());
+    EXPECT_EQ(nodes[0_gc_n].call_count, 2);
+    EXPECT_EQ(nodes[0_gc_n].skip_count, 0);
+    EXPECT_EQ(nodes[1_gc_n].call_count, 1);
+    EXPECT_EQ(nodes[1_gc_n].skip_count, 1);
+    EXPECT_EQ(nodes[2_gc_n].call_count, 2);
+    EXPECT_EQ(nodes[0_gc_n].edge_bytes, 0);
+    EXPECT_EQ(nodes[2_gc_n].edge_bytes, 4 * sizeof(mpk::mix::value::Value));
+
+    auto labels = std::array{ "a"sv, "b"sv, "c"sv };
+    auto json = std::ostringstream{};
+    gc::print_profile_json(json, *result.profile, labels);
+    EXPECT_NE(json.str().find("\"label\": \"c\", \"calls\": 2"),
+              std::string::npos);
+}
+
+TEST(Gc, compute_sweep)
+{
+    // [0]  [1]
+    //  |    |
+    //  0    1
+    //  |    |
+    //  v    v
+    //  2 <--+
+    auto g = test_graph({{1, 1}, {1, 1}, {2, 1}},
+                        {edge({0,0}, {2,0}),
+                         edge({1,0}, {2,1})});
+
+    auto c = gc::computation(g, {});
+
+    auto parameters = std::array{
+        gc::SweepParameter{ .index = 1, .values = {0, 1, 2, 3, 4} } };
+    auto variants = gc::sweep_variants(parameters);
+    ASSERT_EQ(variants.size(), 5);
+
+    auto pool = common::ThreadPool{ 3 };
+    auto outputs = std::vector<int>(variants.size(), -1);
+    EXPECT_TRUE(gc::compute_sweep(
+        c,
+        variants,
+        [&](size_t ivariant, const gc::ComputationResult& result)
+        { outputs.at(ivariant) = group(result.outputs, 2_gc_n)[0_gc_o].as<int>(); },
+        {},
+        pool));
+
+    EXPECT_EQ(outputs, (std::vector<int>{3, 4, 5, 6, 7}));
+
+    // Node not depending on the swept input is computed once
+    auto computation_count = [&](gc::NodeIndex inode)
+    {
+        return static_cast<const TestNode*>(
+            g.nodes[inode].get())->computation_count();
+    };
+    EXPECT_EQ(computation_count(0_gc_n), 1);
+    EXPECT_EQ(computation_count(1_gc_n), 5);
+    EXPECT_EQ(computation_count(2_gc_n), 5);
+
+    // The first variant remains in the computation
+    EXPECT_EQ(group(c.result.outputs, 2_gc_n)[0_gc_o].as<int>(), 3);
+}
+
+TEST(Gc, sweep_variants)
+{
+    auto parameters = std::array{
+        gc::SweepParameter{ .index = 0, .values = {1, 2} },
+        gc::SweepParameter{ .index = 3, .values = {10, 20, 30} } };
+    auto variants = gc::sweep_variants(parameters);
+    ASSERT_EQ(variants.size(), 6);
+
+    auto formatted = std::vector<std::pair<int, int>>{};
+    for (const auto& v : variants)
+    {
+        ASSERT_EQ(v.inputs.size(), 2);
+        EXPECT_EQ(v.inputs[0].index, 0);
+        EXPECT_EQ(v.inputs[1].index, 3);
+        formatted.emplace_back(v.inputs[0].value.as<int>(),
+                               v.inputs[1].value.as<int>());
+    }
+    EXPECT_EQ(formatted,
+              (std::vector<std::pair<int, int>>{
+                  {1, 10}, {1, 20}, {1, 30}, {2, 10}, {2, 20}, {2, 30}}));
+}
+
+TEST(Gc, evolution_feedback)
+{
+    // [0]
+    //  |
+    //  0 -> 1 -> 2
+    //       ^    |
+    //       +----+ feedback
+    auto g = test_graph({{1, 1}, {1, 1}, {1, 1}},
+                        {edge({0,0}, {1,0}),
+                         edge({1,0}, {2,0})});
+
+    auto [instr, source_inputs] = gc::compile(g);
+
+    // Node 2 depends on the sink, so buffers are swapped rather than copied
+    auto evolution = gc::GraphEvolution{
+        .feedback = {
+            gc::make_evolution_feedback(
+                g, { 2_gc_n, 0_gc_o }, { { 1_gc_n, 0_gc_i } }) } };
+    EXPECT_TRUE(evolution.feedback[0].swap_buffers);
+    EXPECT_FALSE(
+        gc::make_evolution_feedback(
+            g, { 0_gc_n, 0_gc_o }, { { 1_gc_n, 0_gc_i } }).swap_buffers);
+
+    auto result = gc::ComputationResult{};
+    auto output = [&]
+    { return group(result.outputs, 2_gc_n)[0_gc_o].as<int>(); };
+
+    EXPECT_TRUE(compute_dirty(result, g, instr.get(), source_inputs, {}, {}));
+    EXPECT_EQ(output(), 3);
+
+    for (auto expected : {5, 7, 9})
+    {
+        gc::set_feedback(result, evolution);
+        EXPECT_TRUE(
+            compute_dirty(result, g, instr.get(), source_inputs, {}, {}));
+        EXPECT_EQ(output(), expected);
+    }
+    EXPECT_EQ(
+        static_cast<const TestNode*>(g.nodes[0_gc_n].get())
+            ->computation_count(),
+        1);
+
+    gc::clear_feedback(result);
+    EXPECT_TRUE(result.updated_inputs.empty());
+
+    // After a reset, the evolution starts over, and all nodes are computed
+    gc::reset_result(result);
+    EXPECT_EQ(result.computation_ts, 0u);
+    EXPECT_TRUE(compute_dirty(result, g, instr.get(), source_inputs, {}, {}));
+    EXPECT_EQ(output(), 3);
+    EXPECT_EQ(
+        static_cast<const TestNode*>(g.nodes[0_gc_n].get())
+            ->computation_count(),
+        2);
+    for (auto expected : {5, 7})
+    {
+        gc::set_feedback(result, evolution);
+        EXPECT_TRUE(
+            compute_dirty(result, g, instr.get(), source_inputs, {}, {}));
+        EXPECT_EQ(output(), expected);
+    }
+    gc::clear_feedback(result);
+}
+
+TEST(Gc, evolution_feedback_cutoff)
+{
+    //   [0]
+    //    |
+    // -> 0 -> 1 -> 2 -+
+    // |               |
+    // +---------------+ feedback
+    //
+    // Output 1 of node 0, hence the output of node 1, does not depend
+    // on the sink, so node 1 is recomputed with the same output
+    auto g = test_graph({{2, 2}, {1, 1}, {1, 1}},
+                        {edge({0,1}, {1,0}),
+                         edge({1,0}, {2,0})});
+
+    auto evolution = gc::GraphEvolution{
+        .feedback = {
+            gc::make_evolution_feedback(
+                g, { 2_gc_n, 0_gc_o }, { { 0_gc_n, 0_gc_i } }) } };
+    EXPECT_TRUE(evolution.feedback[0].swap_buffers);
+
+    auto [instr, source_inputs] = gc::compile(g);
+    gc::enable_versions(source_inputs);
+
+    auto result = gc::ComputationResult{};
+    result.fingerprint = [](const mpk::mix::value::Value& value)
+    { return gc::Fingerprint{}.add(value.as<int>()).value(); };
+    auto output = [&]
+    { return group(result.outputs, 2_gc_n)[0_gc_o].as<int>(); };
+
+    compute(result, g, instr.get(), source_inputs);
+    EXPECT_EQ(output(), 4);
+
+    // The source is not recomputed, so its output is copied to the sink
+    // rather than swapped with the previous sink value
+    for (auto step=0; step<3; ++step)
+    {
+        gc::set_feedback(result, evolution);
+        EXPECT_TRUE(
+            compute_dirty(result, g, instr.get(), source_inputs, {}, {}));
+        EXPECT_EQ(output(), 4);
+        EXPECT_EQ(group(result.inputs, 0_gc_n)[0_gc_i].as<int>(), 4);
+    }
+    gc::clear_feedback(result);
+}
+
+TEST(Gc, evolution_interrupted)
+{
+    // [0]
+    //  |
+    //  0 -> 1 <- [0]
+    //       ^    |
+    //       +----+ feedback
+    auto g = gc::ComputationGraph{};
+    g.nodes.emplace_back(std::make_shared<TestNode>(1, 1));
+    g.nodes.emplace_back(std::make_shared<InterruptibleTestNode>());
+    g.edges.push_back(edge({0,0}, {1,0}));
+
+    auto evolution = gc::GraphEvolution{
+        .feedback = {
+            gc::make_evolution_feedback(
+                g, { 1_gc_n, 0_gc_o }, { { 1_gc_n, 1_gc_i } }) } };
+    EXPECT_TRUE(evolution.feedback[0].swap_buffers);
+
+    auto [instr, source_inputs] = gc::compile(g);
+    gc::enable_versions(source_inputs);
+
+    auto evolve = [&](size_t steps, std::optional<size_t> interrupted_step)
+    {
+        auto result = gc::ComputationResult{};
+        auto outputs = std::vector<int>{};
+        auto step = [&](const std::stop_token& stoken)
+        {
+            gc::set_feedback(result, evolution);
+            auto ok = compute_dirty(
+                result, g, instr.get(), source_inputs, stoken, {});
+            gc::clear_feedback(result);
+            return ok;
+        };
+
+        compute(result, g, instr.get(), source_inputs);
+        for (size_t i=1; i<=steps; ++i)
+        {
+            if (i == interrupted_step)
+            {
+                auto stop_source = std::stop_source{};
+                stop_source.request_stop();
+                EXPECT_FALSE(step(stop_source.get_token()));
+            }
+            EXPECT_TRUE(step({}));
+            outputs.push_back(group(result.outputs, 1_gc_n)[0_gc_o].as<int>());
+        }
+        return outputs;
+    };
+
+    // The interrupted step is repeated when the evolution is resumed
+    auto expected = std::vector<int>{ 2, 3, 4, 5 };
+    EXPECT_EQ(evolve(4, std::nullopt), expected);
+    EXPECT_EQ(evolve(4, 2), expected);
+}
+
+TEST(Gc, constant_folding)
+{
+    // [0]
+    //  |
+    //  0 -> 1 -> 2
+    //       ^    |
+    //       +----+ feedback
+    auto g = test_graph({{1, 1}, {2, 1}, {1, 1}},
+                        {edge({0,0}, {1,0}),
+                         edge({1,0}, {2,0})});
+
+    auto evolution = gc::GraphEvolution{
+        .feedback = {
+            gc::make_evolution_feedback(
+                g, { 2_gc_n, 0_gc_o }, { { 1_gc_n, 1_gc_i } }) } };
+
+    auto [instr, source_inputs] = gc::compile(
+        g, {}, { .variable_inputs = evolution.feedback[0].sinks });
+
+    // The sink is a source input, so it must only be set once
+    gc::enable_versions(source_inputs);
+
+    auto pool = common::ThreadPool{ 2 };
+    for (auto dataflow : { false, true })
+    {
+        auto result = gc::ComputationResult{};
+        result.profile = std::make_shared<gc::ComputationProfile>();
+        const auto& nodes = result.profile->nodes;
+        auto compute_step = [&]
+        {
+            gc::set_feedback(result, evolution);
+            EXPECT_TRUE(
+                dataflow
+                    ? compute(result, g, instr.get(), source_inputs,
+                              {}, {}, pool)
+                    : compute(result, g, instr.get(), source_inputs,
+                              {}, {}));
+        };
+
+        compute(result, g, instr.get(), source_inputs);
+        for (auto expected : {6, 9, 12})
+        {
+            compute_step();
+            EXPECT_EQ(group(result.outputs, 2_gc_n)[0_gc_o].as<int>(),
+                      expected);
+        }
+
+        // Static node 0 is not even visited by evolution steps
+        EXPECT_EQ(nodes[0_gc_n].call_count, 1);
+        EXPECT_EQ(nodes[0_gc_n].skip_count, 0);
+        EXPECT_EQ(nodes[1_gc_n].call_count, 4);
+        EXPECT_EQ(nodes[2_gc_n].call_count, 4);
+
+        // Editing an input of a static node makes it computed again
+        ++source_inputs.values[0].as<int>();
+        gc::touch(source_inputs, 0);
+        compute_step();
+        EXPECT_EQ(nodes[0_gc_n].call_count, 2);
+        EXPECT_EQ(group(result.outputs, 2_gc_n)[0_gc_o].as<int>(), 16);
+
+        compute_step();
+        EXPECT_EQ(nodes[0_gc_n].call_count, 2);
+        EXPECT_EQ(nodes[0_gc_n].skip_count, 0);
+        EXPECT_EQ(group(result.outputs, 2_gc_n)[0_gc_o].as<int>(), 20);
+
+        --source_inputs.values[0].as<int>();
+        gc::touch(source_inputs, 0);
+    }
+}
+
+TEST(Gc, evolve_pipelined)
+{
+    // [0]
+    //  |
+    //  0 -> 1 -> 2 -> 3
+    //       ^    |
+    //       +----+ feedback
+    auto g = test_graph({{1, 1}, {1, 1}, {1, 1}, {1, 1}},
+                        {edge({0,0}, {1,0}),
+                         edge({1,0}, {2,0}),
+                         edge({2,0}, {3,0})});
+
+    auto c = gc::computation(g, {});
+    auto evolution = gc::GraphEvolution{
+        .feedback = {
+            gc::make_evolution_feedback(
+                g, { 1_gc_n, 0_gc_o }, { { 1_gc_n, 0_gc_i } }) } };
+
+    auto output = [](const gc::ComputationResult& result, gc::NodeIndex inode)
+    { return group(result.outputs, inode)[0_gc_o].as<int>(); };
+
+    EXPECT_TRUE(compute_dirty(c, {}, {}));
+    EXPECT_EQ(output(c.result, 3_gc_n), 4);
+
+    // Node 1 is in the loop, nodes 2 and 3 are post-processing nodes
+    auto steps = std::vector<size_t>{};
+    auto outputs = std::vector<int>{};
+    EXPECT_TRUE(gc::evolve_pipelined(
+        c, evolution, 5, 2,
+        [&](size_t step, const gc::ComputationResult& result)
+        {
+            steps.push_back(step);
+            outputs.push_back(output(result, 3_gc_n));
+        },
+        {}));
+
+    EXPECT_EQ(steps, (std::vector<size_t>{1, 2, 3, 4, 5}));
+    EXPECT_EQ(outputs, (std::vector<int>{5, 6, 7, 8, 9}));
+
+    // The result is the same as after sequential steps
+    EXPECT_EQ(output(c.result, 1_gc_n), 7);
+    EXPECT_EQ(output(c.result, 3_gc_n), 9);
+    auto computation_count = [&](gc::NodeIndex inode)
+    {
+        return static_cast<const TestNode*>(
+            g.nodes[inode].get())->computation_count();
+    };
+    EXPECT_EQ(computation_count(0_gc_n), 1);
+    EXPECT_EQ(computation_count(3_gc_n), 6);
+
+    // Nothing is recomputed afterwards
+    EXPECT_TRUE(compute_dirty(c, {}, {}));
+    EXPECT_EQ(computation_count(1_gc_n), 6);
+    EXPECT_EQ(computation_count(3_gc_n), 6);
+
+    // Outputs of loop nodes are passed to the handler on request
+    auto loop_outputs = std::vector<int>{};
+    auto handled = std::array{ gc::EdgeOutputEnd{ 1_gc_n, 0_gc_o } };
+    EXPECT_TRUE(gc::evolve_pipelined(
+        c, evolution, 2, 2,
+        [&](size_t, const gc::ComputationResult& result)
+        { loop_outputs.push_back(output(result, 1_gc_n)); },
+        {},
+        handled));
+    EXPECT_EQ(loop_outputs, (std::vector<int>{8, 9}));
+}
+
+TEST(Gc, progress_aggregator)
+{
+    constexpr size_t node_count = 4;
+    constexpr int report_count = 1000;
+    auto aggregator = gc::ProgressAggregator{ node_count };
+
+    auto sampled = std::vector<double>(node_count, -1);
+    auto sample_count = 0;
+    auto progress = [&](gc::NodeIndex inode, double node_progress)
+    {
+        ++sample_count;
+        sampled.at(inode.v) = node_progress;
+    };
+
+    {
+        // Nodes 1 and 3 report progress concurrently; node 0 does not report
+        auto reporter = gc::ProgressReporter{
+            aggregator, gc::GraphProgress{ &progress },
+            std::chrono::milliseconds{ 1 } };
+        auto report = [&](gc::NodeIndex inode)
+        {
+            for (int i=1; i<=report_count; ++i)
+                aggregator(inode, double(i) / report_count);
+        };
+        auto t1 = std::jthread{ report, 1_gc_n };
+        auto t3 = std::jthread{ report, 3_gc_n };
+        aggregator(2_gc_n, 0.5);
+    }
+
+    // Last values are passed on when the reporter is destroyed
+    EXPECT_EQ(sampled, (std::vector<double>{-1, 1, 0.5, 1}));
+
+    // Only changes are passed on
+    sample_count = 0;
+    EXPECT_EQ(aggregator.sample(gc::GraphProgress{ &progress }), 0u);
+    aggregator(0_gc_n, 0);
+    EXPECT_EQ(aggregator.sample(gc::GraphProgress{ &progress }), 1u);
+    EXPECT_EQ(sample_count, 1);
+    EXPECT_EQ(sampled[0], 0);
+
+    // Reset forgets all progress
+    aggregator.reset(node_count);
+    aggregator(2_gc_n, 0.5);
+    EXPECT_EQ(aggregator.sample(gc::GraphProgress{ &progress }), 1u);
+}
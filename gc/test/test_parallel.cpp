@@ -0,0 +1,114 @@
+/** @file
+ * @brief Tests of data-parallel helpers.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "gc/parallel.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <stop_token>
+#include <vector>
+
+
+TEST(Gc_Parallel, ForVisitsEachIndexOnce)
+{
+    constexpr size_t n = 10007;
+    auto visits = std::vector<std::atomic<int>>(n);
+    auto progress_calls = 0;
+    auto last_progress = 0.;
+    auto progress = [&](double value)
+    {
+        ++progress_calls;
+        EXPECT_GE(value, last_progress);
+        last_progress = value;
+    };
+
+    EXPECT_TRUE(gc::parallel_for(
+        n,
+        [&](size_t begin, size_t end)
+        {
+            for (auto i=begin; i<end; ++i)
+                ++visits[i];
+        },
+        {},
+        gc::NodeProgress{ &progress }));
+
+    for (const auto& v : visits)
+        EXPECT_EQ(v, 1);
+    EXPECT_GT(progress_calls, 0);
+    EXPECT_EQ(last_progress, 1.);
+}
+
+TEST(Gc_Parallel, Reduce)
+{
+    constexpr size_t n = 100000;
+    auto sum = gc::parallel_reduce(
+        n,
+        uint64_t{},
+        [](size_t begin, size_t end)
+        {
+            auto result = uint64_t{};
+            for (auto i=begin; i<end; ++i)
+                result += i;
+            return result;
+        },
+        std::plus<uint64_t>{},
+        {});
+    ASSERT_TRUE(sum.has_value());
+    EXPECT_EQ(*sum, uint64_t{n}*(n-1)/2);
+}
+
+TEST(Gc_Parallel, Nested)
+{
+    // Parallel loops started from pool threads do not deadlock
+    auto count = std::atomic<size_t>{};
+    EXPECT_TRUE(gc::parallel_for(
+        64,
+        [&](size_t begin, size_t end)
+        {
+            gc::parallel_for(
+                (end - begin) * 100,
+                [&](size_t b, size_t e){ count += e - b; },
+                {});
+        },
+        {}));
+    EXPECT_EQ(count, 6400);
+}
+
+TEST(Gc_Parallel, Stop)
+{
+    auto stop_source = std::stop_source{};
+    stop_source.request_stop();
+    auto visited = std::atomic<size_t>{};
+    EXPECT_FALSE(gc::parallel_for(
+        1000,
+        [&](size_t begin, size_t end){ visited += end - begin; },
+        stop_source.get_token()));
+    EXPECT_EQ(visited, 0);
+
+    EXPECT_FALSE(gc::parallel_reduce(
+        1000, 0, [](size_t, size_t){ return 1; }, std::plus<int>{},
+        stop_source.get_token()).has_value());
+}
+
+TEST(Gc_Parallel, Exception)
+{
+    EXPECT_THROW(
+        gc::parallel_for(
+            1000,
+            [](size_t begin, size_t)
+            {
+                if (begin == 0)
+                    throw std::runtime_error("test");
+            },
+            {}),
+        std::runtime_error);
+}
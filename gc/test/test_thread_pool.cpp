@@ -0,0 +1,56 @@
+/** @file
+ * @brief TODO: Brief docstring.
+ *
+ * TODO: More documentation here
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "common/thread_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <functional>
+
+
+TEST(Common_ThreadPool, RunTasks)
+{
+    auto pool = common::ThreadPool{ 4 };
+    EXPECT_EQ(pool.thread_count(), 4);
+
+    constexpr auto task_count = 1000;
+    auto sum = std::atomic<int>{};
+    auto done = std::atomic<int>{};
+    for (int i=0; i<task_count; ++i)
+        pool.submit([&, i]{ sum += i; ++done; });
+
+    pool.run_until([&]{ return done == task_count; });
+    EXPECT_EQ(sum, task_count*(task_count-1)/2);
+}
+
+TEST(Common_ThreadPool, NestedTasks)
+{
+    auto pool = common::ThreadPool{ 3 };
+
+    // Each task spawns two more tasks, down to the specified depth
+    constexpr auto depth = 10;
+    auto done = std::atomic<int>{};
+    auto task = std::function<void(int)>{};
+    task = [&](int level)
+    {
+        if (level < depth)
+        {
+            pool.submit([&, level]{ task(level+1); });
+            pool.submit([&, level]{ task(level+1); });
+        }
+        ++done;
+    };
+    pool.submit([&]{ task(0); });
+
+    constexpr auto total = (1 << (depth+1)) - 1;
+    pool.run_until([&]{ return done == total; });
+    EXPECT_EQ(done, total);
+}
@@ -0,0 +1,23 @@
+/** @file
+ * @brief Hashes of values of gc_app used to detect unchanged node outputs.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include "mpk/mix/value/value_fwd.hpp"
+
+#include <cstdint>
+
+
+namespace gc_app {
+
+// Same as `gc_types::value_fingerprint`, and also hashes cellular
+// automaton rules.
+auto value_fingerprint(const mpk::mix::value::Value& value)
+    -> uint64_t;
+
+} // namespace gc_app
@@ -13,13 +13,17 @@
 #include "gc_app/types/cell2d_rules.hpp"
 
 #include "gc_types/image.hpp"
+#include "gc_types/output_image.hpp"
 
+#include "gc/cancellation.hpp"
 #include "gc/expect_n_node_args.hpp"
 #include "gc/computation_node.hpp"
 #include "gc/node_port_names.hpp"
+#include "gc/parallel.hpp"
 
 #include "mpk/mix/func_ref/func_ref.hpp"
 
+#include <algorithm>
 #include <cassert>
 
 
@@ -34,6 +38,12 @@ namespace {
 
 constexpr int8_t NoChange = -128;
 
+// Minimal number of cells processed by a parallel task
+constexpr size_t min_task_cells = 1 << 16;
+
+auto row_grain(size_t width) -> size_t
+{ return std::max<size_t>(min_task_cells / std::max<size_t>(width, 1), 1); }
+
 template <int NeighborhoodSize>
 class RtRules final
 {
@@ -99,7 +109,7 @@ public:
     auto compute_outputs(
             gc::OutputValues result,
             gc::ConstInputValues inputs,
-            const std::stop_token&,
+            const std::stop_token& stoken,
             const gc::NodeProgress& progress) const
         -> bool override
     {
@@ -108,21 +118,10 @@ public:
         const auto& rules = inputs[0_gc_i].as<Cell2dRules>();
         const auto& in_image = inputs[1_gc_i].as<I8Image>();
 
-        auto& out_image = [&]() -> I8Image&
-        {
-            static const auto* I8Image_type = mpk::mix::value::type_of<I8Image>();
-            auto& out = result.front();
-            if (out.type() == I8Image_type)
-            {
-                auto& image = out.as<I8Image>();
-                if (image.size == in_image.size)
-                    return image;
-            }
-            out = in_image;
-            return out.as<I8Image>();
-        }();
+        auto& out_image = output_image(result.front(), in_image);
 
-        advance(out_image, in_image, rules);
+        if (!advance(out_image, in_image, rules, stoken))
+            return false;
 
         if (progress)
             progress(1);
@@ -139,13 +138,14 @@ private:
         std::bool_constant<count_self>,
         I8Image& out,
         const I8Image& in,
-        const Cell2dRules& rules) -> void
+        const Cell2dRules& rules,
+        const std::stop_token& stoken) -> bool
     {
         assert(out.size == in.size);
         auto h = in.size.height;
         auto w = in.size.width;
         if (h == 0 || w == 0)
-            return;
+            return true;
         auto const* src = in.data.data();
         auto* dst = out.data.data();
 
@@ -202,24 +202,34 @@ private:
         auto rtr9 = RtRules<9>(
             rules.state_count, rules.min_state, rules.map9);
 
-        auto const* prev_line = line(src, h-1);
-        auto const* cur_line = line(src, 0);
-        for (size_t y=0; y<h; ++y)
+        auto rows = [&](size_t y0, size_t y1)
         {
-            auto const* next_line = line(src, (y+1)%h);
-            auto* dst_line = line(dst, y);
-            dst_line[0] =
-                rtr9(cur_line[0], n_sum_l(prev_line, cur_line, next_line));
-            for (size_t x=0; x+2<w; ++x)
+            auto checkpoint =
+                gc::CancellationCheckpoint{ stoken, gc::cancellation_rows(w) };
+            auto const* prev_line = line(src, (y0+h-1)%h);
+            auto const* cur_line = line(src, y0);
+            for (size_t y=y0; y<y1; ++y)
             {
-                auto s = n_sum(prev_line+x, cur_line+x, next_line+x);
-                dst_line[x+1] = rtr9(cur_line[x+1], s);
+                if (checkpoint())
+                    return;
+
+                auto const* next_line = line(src, (y+1)%h);
+                auto* dst_line = line(dst, y);
+                dst_line[0] = rtr9(
+                    cur_line[0], n_sum_l(prev_line, cur_line, next_line));
+                for (size_t x=0; x+2<w; ++x)
+                {
+                    auto s = n_sum(prev_line+x, cur_line+x, next_line+x);
+                    dst_line[x+1] = rtr9(cur_line[x+1], s);
+                }
+                dst_line[w-1] = rtr9(
+                    cur_line[w-1], n_sum_r(prev_line, cur_line, next_line));
+                prev_line = cur_line;
+                cur_line = next_line;
             }
-            dst_line[w-1] =
-                rtr9(cur_line[w-1], n_sum_r(prev_line, cur_line, next_line));
-            prev_line = cur_line;
-            cur_line = next_line;
-        }
+        };
+
+        return gc::parallel_for(h, rows, stoken, {}, row_grain(w));
     }
 
     template <bool count_self>
@@ -228,13 +238,14 @@ private:
         std::bool_constant<count_self>,
         I8Image& out,
         const I8Image& in,
-        const Cell2dRules& rules) -> void
+        const Cell2dRules& rules,
+        const std::stop_token& stoken) -> bool
     {
         assert(out.size == in.size);
         auto h = in.size.height;
         auto w = in.size.width;
         if (h < 2 || w < 2)
-            return;
+            return true;
         auto const* src = in.data.data();
         auto* dst = out.data.data();
 
@@ -373,11 +384,11 @@ private:
         auto rtr4 = RtRules<4>(
             rules.state_count, rules.min_state, rules.map4);
 
-        auto const* prev_line = line(src, 0);
-        auto const* cur_line = prev_line;
+        auto top_row = [&](size_t y)
         {
-            auto const* next_line = line(src, 1);
-            auto* dst_line = line(dst, 0);
+            auto const* cur_line = line(src, y);
+            auto const* next_line = line(src, y+1);
+            auto* dst_line = line(dst, y);
             dst_line[0] =
                 rtr4(cur_line[0], n_sum_lt(cur_line, next_line));
             for (size_t x=1; x+1<w; ++x)
@@ -387,12 +398,13 @@ private:
             }
             dst_line[w-1] =
                 rtr4(cur_line[w-1], n_sum_rt(cur_line, next_line));
-            prev_line = cur_line;
-            cur_line = next_line;
-        }
-        for (size_t y=1; y+1<h; ++y)
+        };
+
+        auto middle_row = [&](size_t y)
         {
-            auto const* next_line = line(src, (y+1));
+            auto const* prev_line = line(src, y-1);
+            auto const* cur_line = line(src, y);
+            auto const* next_line = line(src, y+1);
             auto* dst_line = line(dst, y);
             dst_line[0] =
                 rtr6(cur_line[0], n_sum_l(prev_line, cur_line, next_line));
@@ -404,11 +416,13 @@ private:
             }
             dst_line[w-1] =
                 rtr6(cur_line[w-1], n_sum_r(prev_line, cur_line, next_line));
-            prev_line = cur_line;
-            cur_line = next_line;
-        }
+        };
+
+        auto bottom_row = [&](size_t y)
         {
-            auto* dst_line = line(dst, h-1);
+            auto const* prev_line = line(src, y-1);
+            auto const* cur_line = line(src, y);
+            auto* dst_line = line(dst, y);
             dst_line[0] =
                 rtr4(cur_line[0], n_sum_lb(prev_line, cur_line));
             for (size_t x=1; x+1<w; ++x)
@@ -418,29 +432,52 @@ private:
             }
             dst_line[w-1] =
                 rtr4(cur_line[w-1], n_sum_rb(prev_line, cur_line));
-        }
+        };
+
+        auto rows = [&](size_t y0, size_t y1)
+        {
+            auto checkpoint =
+                gc::CancellationCheckpoint{ stoken, gc::cancellation_rows(w) };
+            for (auto y=y0; y<y1; ++y)
+            {
+                if (checkpoint())
+                    return;
+
+                if (y == 0)
+                    top_row(y);
+                else if (y+1 == h)
+                    bottom_row(y);
+                else
+                    middle_row(y);
+            }
+        };
+
+        return gc::parallel_for(h, rows, stoken, {}, row_grain(w));
     }
 
     static auto advance(
-        I8Image& out, const I8Image& in, const Cell2dRules& rules) -> void
+        I8Image& out,
+        const I8Image& in,
+        const Cell2dRules& rules,
+        const std::stop_token& stoken) -> bool
     {
         auto on_count_self = [&](auto shape, auto count_self)
         {
-            advance_impl(shape, count_self, out, in, rules);
+            return advance_impl(shape, count_self, out, in, rules, stoken);
         };
 
         auto on_shape = [&](auto shape)
         {
             if (rules.count_self)
-                on_count_self(shape, std::true_type{});
+                return on_count_self(shape, std::true_type{});
             else
-                on_count_self(shape, std::false_type{});
+                return on_count_self(shape, std::false_type{});
         };
 
         if (rules.tor)
-            on_shape(Tor);
+            return on_shape(Tor);
         else
-            on_shape(Rect);
+            return on_shape(Rect);
     }
 };
 
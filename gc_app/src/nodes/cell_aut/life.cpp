@@ -11,8 +11,10 @@
 #include "gc_app/nodes/cell_aut/life.hpp"
 
 #include "gc_types/image.hpp"
+#include "gc_types/output_image.hpp"
 #include "gc_types/uint.hpp"
 
+#include "gc/cancellation.hpp"
 #include "gc/expect_n_node_args.hpp"
 #include "gc/computation_node.hpp"
 #include "gc/node_port_names.hpp"
@@ -77,7 +79,7 @@ public:
     auto compute_outputs(
             gc::OutputValues result,
             gc::ConstInputValues inputs,
-            const std::stop_token&,
+            const std::stop_token& stoken,
             const gc::NodeProgress& progress) const
         -> bool override
     {
@@ -85,21 +87,10 @@ public:
         assert(result.size() == 1_gc_oc);
         auto const& in_image = inputs.front().as<I8Image>();
 
-        auto& out_image = [&]() -> I8Image&
-        {
-            static const auto* I8Image_type = mpk::mix::value::type_of<I8Image>();
-            auto& out = result.front();
-            if (out.type() == I8Image_type)
-            {
-                auto& image = out.as<I8Image>();
-                if (image.size == in_image.size)
-                    return image;
-            }
-            out = in_image;
-            return out.as<I8Image>();
-        }();
+        auto& out_image = output_image(result.front(), in_image);
 
-        advance(out_image, in_image);
+        if (!advance(out_image, in_image, stoken))
+            return false;
 
         if (progress)
             progress(1);
@@ -107,13 +98,15 @@ public:
     }
 
 private:
-    static auto advance(I8Image& out, I8Image const& in) -> void
+    static auto advance(I8Image& out,
+                        I8Image const& in,
+                        const std::stop_token& stoken) -> bool
     {
         assert(out.size == in.size);
         auto h = in.size.height;
         auto w = in.size.width;
         if (h == 0 || w == 0)
-            return;
+            return true;
         auto const* src = in.data.data();
         auto* dst = out.data.data();
 
@@ -150,10 +143,15 @@ private:
             {{ 0, 0, 0, 1, 0, 0, 0, 0, 0 },
              { 0, 0, 1, 1, 0, 0, 0, 0, 0 }};
 
+        auto checkpoint =
+            gc::CancellationCheckpoint{ stoken, gc::cancellation_rows(w) };
         auto const* prev_line = line(src, h-1);
         auto const* cur_line = line(src, 0);
         for (size_t y=0; y<h; ++y)
         {
+            if (checkpoint())
+                return false;
+
             auto const* next_line = line(src, (y+1)%h);
             auto* dst_line = line(dst, y);
             dst_line[0] =
@@ -169,6 +167,7 @@ private:
             prev_line = cur_line;
             cur_line = next_line;
         }
+        return true;
     }
 };
 
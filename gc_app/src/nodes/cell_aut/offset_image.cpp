@@ -11,13 +11,17 @@
 #include "gc_app/nodes/cell_aut/offset_image.hpp"
 
 #include "gc_types/image.hpp"
+#include "gc_types/image_kernel.hpp"
+#include "gc_types/output_image.hpp"
 
+#include "gc/cancellation.hpp"
 #include "gc/expect_n_node_args.hpp"
 #include "gc/computation_node.hpp"
 #include "gc/node_port_names.hpp"
 
 #include "mpk/mix/func_ref/func_ref.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <random>
 
@@ -59,7 +63,7 @@ public:
     auto compute_outputs(
             gc::OutputValues result,
             gc::ConstInputValues inputs,
-            const std::stop_token&,
+            const std::stop_token& stoken,
             const gc::NodeProgress& progress) const
         -> bool override
     {
@@ -68,26 +72,23 @@ public:
         const auto& input_image = inputs[0_gc_i].as<I8Image>();
         auto offset = inputs[1_gc_i].convert_to<int8_t>();
 
-        auto& output_image = [&]() -> I8Image&
-        {
-            static const auto* I8Image_type = mpk::mix::value::type_of<I8Image>();
-            auto& out = result.front();
-            if (out.type() == I8Image_type)
+        auto& output_image =
+            gc_types::output_image<int8_t>(result.front(), input_image.size);
+
+        const auto* input_pixels = input_image.data.data();
+        auto* output_pixels = output_image.data.data();
+        auto computed = gc::for_blocks(
+            input_image.data.size(),
+            [&](size_t begin, size_t end)
             {
-                auto& image = out.as<I8Image>();
-                if (image.size == input_image.size)
-                    return image;
-            }
-            out = I8Image{
-                .size = input_image.size,
-                .data = std::vector<int8_t>(input_image.data.size())
-            };
-            return out.as<I8Image>();
-        }();
-
-        std::ranges::transform(
-            input_image.data, output_image.data.begin(),
-            [&](int8_t pixel){ return pixel + offset; });
+                std::transform(
+                    input_pixels + begin, input_pixels + end,
+                    output_pixels + begin,
+                    [&](int8_t pixel){ return pixel + offset; });
+            },
+            stoken);
+        if (!computed)
+            return false;
 
         if (progress)
             progress(1);
@@ -95,6 +96,23 @@ public:
         return true;
     }
 
+    auto elementwise_ports() const
+        -> std::optional<gc::ElementwisePorts> override
+    { return gc::ElementwisePorts{ .input = 0_gc_i, .output = 0_gc_o }; }
+
+    // The output image is the input image when they have the same size
+    auto in_place_ports() const
+        -> std::optional<gc::InPlacePorts> override
+    { return gc::InPlacePorts{ .input = 0_gc_i, .output = 0_gc_o }; }
+
+    auto elementwise_kernel(gc::ConstInputValues inputs) const
+        -> gc::ElementwiseKernel override
+    {
+        auto offset = inputs[1_gc_i].convert_to<int8_t>();
+        return image_kernel<int8_t, int8_t>(
+            [offset](int8_t pixel) -> int8_t { return pixel + offset; });
+    }
+
 private:
     static auto generate_image(
         const UintSize& size,
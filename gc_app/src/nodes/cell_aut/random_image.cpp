@@ -11,6 +11,7 @@
 #include "gc_app/nodes/cell_aut/random_image.hpp"
 
 #include "gc_types/image.hpp"
+#include "gc_types/output_image.hpp"
 
 #include "gc/expect_n_node_args.hpp"
 #include "gc/computation_node.hpp"
@@ -63,6 +64,11 @@ public:
         result[6_gc_i] = int8_t{0};
     }
 
+    // Outputs are random, so the same inputs do not mean the same outputs
+    auto cacheable() const
+        -> bool override
+    { return false; }
+
     auto compute_outputs(
             gc::OutputValues result,
             gc::ConstInputValues inputs,
@@ -77,11 +83,17 @@ public:
         auto range_size = inputs[2_gc_i].convert_to<int8_t>();
         const auto& map = inputs[3_gc_i].as<std::vector<int8_t>>();
         auto radius = inputs[4_gc_i].convert_to<int>();
-        auto shape = inputs[5_gc_i].convert_to<std::string_view>();
+        auto shape_str = inputs[5_gc_i].convert_to<std::string_view>();
         auto outer_state = inputs[6_gc_i].convert_to<int8_t>();
 
-        result[0_gc_o] = generate_image(
-            size, lowest_state, range_size, map, radius, shape, outer_state);
+        // Validate inputs before acquiring the output, so that invalid
+        // inputs leave the previous image intact
+        check_inputs(size, range_size, map);
+        auto shape = radius < 0 ? Shape::circle : parse_shape(shape_str);
+
+        generate_image(
+            output_image<int8_t>(result[0_gc_o], size),
+            lowest_state, range_size, map, radius, shape, outer_state);
 
         if (progress)
             progress(1);
@@ -90,14 +102,12 @@ public:
     }
 
 private:
-    static auto generate_image(
+    enum class Shape{ circle, rectangle };
+
+    static auto check_inputs(
         const UintSize& size,
-        int8_t lowest_state,
         int8_t range_size,
-        const std::vector<int8_t>& map,
-        int radius,
-        std::string_view shape_str,
-        int8_t outer_state) -> I8Image
+        const std::vector<int8_t>& map) -> void
     {
         if (range_size == 0)
             throw std::invalid_argument(
@@ -105,31 +115,43 @@ private:
         if (size.width < 1 || size.height < 1)
             throw std::invalid_argument(
                 "RandomImage: image width and height must both be positive");
+        if (!map.empty() && map.size() != static_cast<size_t>(range_size))
+            throw std::invalid_argument(
+                "RandomImage: Map size must be either zero or range_size");
+    }
+
+    static auto parse_shape(std::string_view shape_str) -> Shape
+    {
+        if (shape_str == "circle")
+            return Shape::circle;
+        if (shape_str == "rectangle")
+            return Shape::rectangle;
+        mpk::mix::throw_<std::invalid_argument>(
+            "Invalid shape '{}'", shape_str);
+    }
+
+    // Inputs must be checked by `check_inputs`
+    static auto generate_image(
+        I8Image& image,
+        int8_t lowest_state,
+        int8_t range_size,
+        const std::vector<int8_t>& map,
+        int radius,
+        Shape shape,
+        int8_t outer_state) -> void
+    {
+        const auto& size = image.size;
 
         std::random_device rd;
         std::mt19937 gen(rd());
         std::uniform_int_distribution<int8_t> distrib(
             lowest_state, lowest_state + range_size - 1);
 
-        auto image = I8Image{
-            .size = size,
-            .data = std::vector<int8_t>(size.width * size.height, 0)
-        };
         if (radius < 0)
             for (auto& pixel : image.data)
                 pixel = distrib(gen);
         else
         {
-            enum class Shape{ circle, rectangle };
-            auto shape = [shape_str]{
-                if (shape_str == "circle")
-                    return Shape::circle;
-                if (shape_str == "rectangle")
-                    return Shape::rectangle;
-                mpk::mix::throw_<std::invalid_argument>(
-                    "Invalid shape '{}'", shape_str);
-            }();
-
             int width = size.width;
             int height = size.height;
             int xc = width / 2;
@@ -163,16 +185,10 @@ private:
 
         if( !map.empty() )
         {
-            if (map.size() != static_cast<size_t>(range_size))
-                throw std::invalid_argument(
-                    "RandomImage: Map size must be either zero or range_size");
-
             // Do the mapping
             for (auto& pixel : image.data)
                 pixel = map.at(pixel - lowest_state) + lowest_state;
         }
-
-        return image;
     }
 
 };
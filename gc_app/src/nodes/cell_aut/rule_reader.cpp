@@ -148,6 +148,11 @@ public:
         result[0_gc_i] = "life.rul"s;
     }
 
+    // The file may change, so the same inputs do not mean the same outputs
+    auto cacheable() const
+        -> bool override
+    { return false; }
+
     auto compute_outputs(
             gc::OutputValues result,
             gc::ConstInputValues inputs,
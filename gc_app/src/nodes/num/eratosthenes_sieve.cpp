@@ -101,6 +101,10 @@ public:
         result.front() = uint_vec_val(std::move(seq));
         return computed;
     }
+
+    auto persistent_cache_id() const
+        -> std::string override
+    { return "EratosthenesSieve"; }
 };
 
 #if 0
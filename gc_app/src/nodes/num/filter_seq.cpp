@@ -12,6 +12,7 @@
 
 #include "gc_types/uint_vec.hpp"
 
+#include "gc/cancellation.hpp"
 #include "gc/expect_n_node_args.hpp"
 #include "gc/computation_node.hpp"
 #include "gc/node_port_names.hpp"
@@ -57,13 +58,17 @@ public:
         auto value = uint_val(inputs[1_gc_i]);
 
         auto filtered = UintVec{};
-        for (size_t i=0, n=seq.size(); i<n; ++i)
-        {
-            if (seq[i] == value)
-                filtered.push_back(Uint(i));
-            if (stoken.stop_requested())
-                return false;
-        }
+        auto computed = gc::for_blocks(
+            seq.size(),
+            [&](size_t begin, size_t end)
+            {
+                for (auto i=begin; i<end; ++i)
+                    if (seq[i] == value)
+                        filtered.push_back(Uint(i));
+            },
+            stoken);
+        if (!computed)
+            return false;
 
         result.front() = uint_vec_val(std::move(filtered));
         return true;
@@ -129,6 +129,10 @@ public:
         result.front() = uint_vec_val(std::move(seq));
         return computed;
     }
+
+    auto persistent_cache_id() const
+        -> std::string override
+    { return "Waring"; }
 };
 
 auto make_waring(mpk::mix::value::ConstValueSpan args, const gc::ComputationContext&)
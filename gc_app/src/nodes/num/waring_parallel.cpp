@@ -13,9 +13,12 @@
 #include "gc_types/multi_index.hpp"
 #include "gc_types/uint_vec.hpp"
 
+#include "common/thread_pool.hpp"
+
 #include "gc/expect_n_node_args.hpp"
 #include "gc/computation_node.hpp"
 #include "gc/node_port_names.hpp"
+#include "gc/parallel.hpp"
 
 #include "mpk/mix/util/binomial.hpp"
 #include "mpk/mix/func_ref/func_ref.hpp"
@@ -25,7 +28,6 @@
 #include <atomic>
 #include <cmath>
 #include <numeric>
-#include <thread>
 
 using namespace std::string_view_literals;
 using namespace gc::literals;
@@ -41,15 +43,15 @@ auto waring_parallel(Uint limit,
                      Uint k,
                      const std::stop_token& stoken,
                      const gc::NodeProgress& progress,
-                     Uint thread_count)
+                     Uint part_count)
     -> std::pair<UintVec, bool>
 {
     assert(s > 0);
     assert(k > 1);
 
     auto local_results = mpk::mix::Grouped<Uint>{};
-    local_results.values.reserve(limit*thread_count);
-    for (Uint p=0; p<thread_count; ++p)
+    local_results.values.reserve(limit*part_count);
+    for (Uint p=0; p<part_count; ++p)
     {
         local_results.values.resize(limit*(p+1), 0);
         next_group(local_results);
@@ -69,13 +71,13 @@ auto waring_parallel(Uint limit,
 
     // Partition multi-index range
     auto mi_ranges = mpk::mix::Grouped<Uint>{};
-    mi_ranges.values.reserve(s * (thread_count+1));
-    for (Uint p=0; p<=thread_count; ++p)
+    mi_ranges.values.reserve(s * (part_count+1));
+    for (Uint p=0; p<=part_count; ++p)
     {
         mi_ranges.values.resize(s * (p+1), {});
         next_group(mi_ranges);
         multi_index_mono_subrange_boundary(
-            group(mi_ranges, p), tlim, p, thread_count);
+            group(mi_ranges, p), tlim, p, part_count);
     }
 
     // Compute number of iterations; initialize progress-specific variables
@@ -83,36 +85,38 @@ auto waring_parallel(Uint limit,
     auto progress_factor = 1. / iter_count;
     auto iter = std::atomic<uint64_t>{0};
     auto iter_granularity =
-        std::max(2ul, mpk::mix::ceil2(iter_count / (100*thread_count))) - 1;
+        std::max(2ul, mpk::mix::ceil2(iter_count / (100*part_count))) - 1;
 
-    auto threads_succeeded = Uint{};
+    auto parts_succeeded = std::atomic<Uint>{};
 
     auto equal = [](const auto& a, const auto& b)
         -> bool
     { return std::equal(a.begin(), a.end(), b.begin()); };
 
-    std::mutex mut;
-    auto last_progress_reported = double{0};
+    // The thread advancing the progress by at least 0.01 reports it;
+    // parts never wait for each other here.
+    auto last_progress_reported = std::atomic<double>{0};
     auto maybe_report_progress = [&]
     {
         if (!progress)
             return;
 
-        double progress_value;
+        auto progress_value = progress_factor * iter;
+        auto last = last_progress_reported.load(std::memory_order_relaxed);
+        do
         {
-            auto lock = std::lock_guard {mut};
-            progress_value = progress_factor * iter;
-            if (progress_value - last_progress_reported < 0.01)
+            if (progress_value - last < 0.01)
                 return;
-            last_progress_reported = progress_value;
         }
+        while (!last_progress_reported.compare_exchange_weak(
+            last, progress_value, std::memory_order_relaxed));
         progress(progress_value);
     };
 
-    auto local_iter_count_lb = iter_count / thread_count;
+    auto local_iter_count_lb = iter_count / part_count;
 
-    // Define thread function
-    auto thread_func = [&](Uint p)
+    // Define function computing one part
+    auto part_func = [&](Uint p)
     {
         // Compute result within p-th multi-index range
         auto mi0 = group(mi_ranges, p);
@@ -155,32 +159,32 @@ auto waring_parallel(Uint limit,
             assert(equal(mi, mi1));
         }
 
-        ++threads_succeeded;
+        ++parts_succeeded;
     };
 
-    // Start threads
+    // Compute parts on the shared thread pool
     if (progress)
         progress(0);
 
-    auto threads = std::vector<std::jthread>{};
-    threads.reserve(thread_count);
-    for (Uint p=0; p<thread_count; ++p)
-        threads.emplace_back(thread_func, p);
-
-    // Wait till all threads finish
-    for (Uint p=0; p<thread_count; ++p)
-        threads[p].join();
+    gc::parallel_for(
+        part_count,
+        [&](size_t begin, size_t end)
+        {
+            for (auto p=begin; p<end; ++p)
+                part_func(static_cast<Uint>(p));
+        },
+        stoken);
 
     // Sum results within each multi-index range
     auto result = UintVec(limit, 0);
-    for (auto p=0u; p<thread_count; ++p)
+    for (auto p=0u; p<part_count; ++p)
     {
         auto local_result = group(local_results, p);
         for (Uint i=0; i<limit; ++i)
             result[i] += local_result[i];
     }
 
-    return { std::move(result),  threads_succeeded == thread_count };
+    return { std::move(result),  parts_succeeded == part_count };
 }
 
 } // anonymous namespace
@@ -189,8 +193,10 @@ class WaringParallel final :
     public gc::ComputationNode
 {
 public:
-    WaringParallel(Uint thread_count)
-        : thread_count_{ thread_count }
+    // The range of iterations is split into `part_count` parts computed
+    // in parallel; zero means the number of shared pool threads.
+    WaringParallel(Uint part_count)
+        : part_count_{ part_count }
     {}
 
     auto input_names() const
@@ -222,14 +228,23 @@ public:
         auto count = uint_val(inputs[0_gc_i]);
         auto s = uint_val(inputs[1_gc_i]);
         auto k = uint_val(inputs[2_gc_i]);
+        auto part_count = part_count_ > 0
+            ? part_count_
+            : static_cast<Uint>(gc::shared_thread_pool().thread_count());
         auto [seq, computed] =
-            waring_parallel(count, s, k, stoken, progress, thread_count_);
+            waring_parallel(count, s, k, stoken, progress, part_count);
         result.front() = uint_vec_val(std::move(seq));
         return computed;
     }
 
+    // Outputs do not depend on the thread count
+    // and are the same as those of `Waring`
+    auto persistent_cache_id() const
+        -> std::string override
+    { return "Waring"; }
+
 private:
-    Uint thread_count_;
+    Uint part_count_;
 };
 
 auto make_waring_parallel(mpk::mix::value::ConstValueSpan args,
@@ -237,8 +252,8 @@ auto make_waring_parallel(mpk::mix::value::ConstValueSpan args,
     -> std::shared_ptr<gc::ComputationNode>
 {
     gc::expect_n_node_args("WaringParallel", args, 1);
-    auto thread_count = args[0].convert_to<Uint>();
-    return std::make_shared<WaringParallel>(thread_count);
+    auto part_count = args[0].convert_to<Uint>();
+    return std::make_shared<WaringParallel>(part_count);
 }
 
 } // namespace gc_app::num
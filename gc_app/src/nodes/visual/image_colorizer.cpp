@@ -11,8 +11,11 @@
 #include "gc_app/nodes/visual/image_colorizer.hpp"
 
 #include "gc_types/image.hpp"
+#include "gc_types/image_kernel.hpp"
+#include "gc_types/output_image.hpp"
 #include "gc_types/palette.hpp"
 
+#include "gc/cancellation.hpp"
 #include "gc/computation_node.hpp"
 #include "gc/expect_n_node_args.hpp"
 #include "gc/node_port_names.hpp"
@@ -61,7 +64,7 @@ public:
     auto compute_outputs(
             gc::OutputValues result,
             gc::ConstInputValues inputs,
-            const std::stop_token&,
+            const std::stop_token& stoken,
             const gc::NodeProgress&) const
         -> bool override
     {
@@ -71,35 +74,45 @@ public:
         const auto& palette = inputs[1_gc_i].as<IndexedPalette>();
         auto min_state = inputs[2_gc_i].convert_to<int8_t>();
 
-        auto& output_image = [&]() -> ColorImage&
-        {
-            static const auto* ColorImage_type = mpk::mix::value::type_of<ColorImage>();
-            auto& out = result.front();
-            if (out.type() == ColorImage_type)
-            {
-                auto& image = out.as<ColorImage>();
-                if (image.size == input_image.size)
-                    return image;
-            }
-            out = ColorImage{
-                .size = input_image.size,
-                .data = std::vector<Color>(input_image.data.size())
-            };
-            return out.as<ColorImage>();
-        }();
-
-        const auto* input_pixel = input_image.data.data();
-        auto* output_pixel = output_image.data.data();
+        auto& output_image =
+            gc_types::output_image<Color>(result.front(), input_image.size);
+
+        const auto* input_pixels = input_image.data.data();
+        auto* output_pixels = output_image.data.data();
         auto N = palette.color_map.size();
-        for (auto _ : mpk::mix::index_range<size_t>(input_image.data.size()))
-        {
-            auto in = *input_pixel++ - min_state;
-            auto out = in >= 0 && static_cast<size_t>(in) < N
-                           ? palette.color_map[in]
-                           : palette.overflow_color;
-            *output_pixel++ = out;
-        }
-        return true;
+        return gc::for_blocks(
+            input_image.data.size(),
+            [&](size_t begin, size_t end)
+            {
+                for (auto i=begin; i<end; ++i)
+                {
+                    auto in = input_pixels[i] - min_state;
+                    output_pixels[i] = in >= 0 && static_cast<size_t>(in) < N
+                                           ? palette.color_map[in]
+                                           : palette.overflow_color;
+                }
+            },
+            stoken);
+    }
+
+    auto elementwise_ports() const
+        -> std::optional<gc::ElementwisePorts> override
+    { return gc::ElementwisePorts{ .input = 0_gc_i, .output = 0_gc_o }; }
+
+    auto elementwise_kernel(gc::ConstInputValues inputs) const
+        -> gc::ElementwiseKernel override
+    {
+        const auto& palette = inputs[1_gc_i].as<IndexedPalette>();
+        auto min_state = inputs[2_gc_i].convert_to<int8_t>();
+        return image_kernel<int8_t, Color>(
+            [palette, min_state](int8_t pixel)
+            {
+                auto in = pixel - min_state;
+                auto N = palette.color_map.size();
+                return in >= 0 && static_cast<size_t>(in) < N
+                    ? palette.color_map[in]
+                    : palette.overflow_color;
+            });
     }
 };
 
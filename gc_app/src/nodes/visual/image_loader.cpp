@@ -216,6 +216,11 @@ public:
         result[1_gc_i] = int8_t{0};
     }
 
+    // The file may change, so the same inputs do not mean the same outputs
+    auto cacheable() const
+        -> bool override
+    { return false; }
+
     auto compute_outputs(
             gc::OutputValues result,
             gc::ConstInputValues inputs,
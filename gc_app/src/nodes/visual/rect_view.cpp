@@ -11,13 +11,17 @@
 #include "gc_app/nodes/visual/rect_view.hpp"
 
 #include "gc_types/image.hpp"
+#include "gc_types/output_image.hpp"
 #include "gc_types/palette.hpp"
 #include "gc_types/uint_vec.hpp"
 
+#include "gc/cancellation.hpp"
 #include "gc/expect_n_node_args.hpp"
 #include "gc/computation_node.hpp"
 #include "gc/node_port_names.hpp"
 
+#include <algorithm>
+
 
 using namespace std::string_view_literals;
 using namespace gc::literals;
@@ -65,23 +69,23 @@ public:
         const auto& size = inputs[0_gc_i].as<UintSize>();
         const auto& seq = inputs[1_gc_i].as<UintVec>();
         const auto& palette = inputs[2_gc_i].as<IndexedPalette>();
-        auto image = Image
-        {
-            .size = size,
-            .data = ColorVec(size.width * size.height,
-                             rgba(Color{0}, ColorComponent{0}))
-        };
+        auto& image = output_image<Color>(result.front(), size);
 
         auto n = std::min(image.data.size(), seq.size());
-        for(size_t index=0; index<n; ++index)
-        {
-            auto value = seq[index];
-            image.data[index] = map_color(palette, value);
-            if (stoken.stop_requested())
-                return false;
-        }
-
-        result.front() = std::move(image);
+        auto computed = gc::for_blocks(
+            n,
+            [&](size_t begin, size_t end)
+            {
+                for (auto index=begin; index<end; ++index)
+                    image.data[index] = map_color(palette, seq[index]);
+            },
+            stoken);
+        if (!computed)
+            return false;
+        std::fill(image.data.begin() + n,
+                  image.data.end(),
+                  rgba(Color{0}, ColorComponent{0}));
+
         return true;
     }
 };
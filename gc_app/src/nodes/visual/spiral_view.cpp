@@ -11,6 +11,7 @@
 #include "gc_app/nodes/visual/rect_view.hpp"
 
 #include "gc_types/image.hpp"
+#include "gc_types/output_image.hpp"
 #include "gc_types/palette.hpp"
 #include "gc_types/uint_vec.hpp"
 
@@ -70,12 +71,8 @@ public:
         const auto& seq = inputs[1_gc_i].as<UintVec>();
         auto scale = inputs[2_gc_i].convert_to<double>();
         const auto& palette = inputs[3_gc_i].as<IndexedPalette>();
-        auto image = Image
-        {
-            .size = size,
-            .data = ColorVec(size.width * size.height,
-                             rgba(Color{0}, ColorComponent{0}))
-        };
+        // All pixels are overwritten below
+        auto& image = output_image<Color>(result.front(), size);
 
         auto n = std::min(image.data.size(), seq.size());
 
@@ -145,7 +142,6 @@ public:
             }
         }
 
-        result.front() = std::move(image);
         return true;
     }
 };
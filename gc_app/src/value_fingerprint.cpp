@@ -0,0 +1,46 @@
+/** @file
+ * @brief Hashes of values of gc_app used to detect unchanged node outputs.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "gc_app/value_fingerprint.hpp"
+
+#include "gc_app/types/cell2d_rules.hpp"
+
+#include "gc_types/value_fingerprint.hpp"
+
+#include "gc/value_fingerprint.hpp"
+
+#include "mpk/mix/value/type.hpp"
+#include "mpk/mix/value/value.hpp"
+
+
+namespace gc_app {
+
+auto value_fingerprint(const mpk::mix::value::Value& value)
+    -> uint64_t
+{
+    using mpk::mix::value::type_of;
+
+    if (value.type() == type_of<Cell2dRules>())
+    {
+        const auto& rules = value.as<Cell2dRules>();
+        return gc::Fingerprint{}
+            .add(static_cast<const void*>(value.type()))
+            .add(rules.state_count)
+            .add(rules.min_state)
+            .add(rules.tor)
+            .add(rules.count_self)
+            .add_values(std::span<const int8_t>{ rules.map9 })
+            .add_values(std::span<const int8_t>{ rules.map6 })
+            .add_values(std::span<const int8_t>{ rules.map4 })
+            .value();
+    }
+
+    return gc_types::value_fingerprint(value);
+}
+
+} // namespace gc_app
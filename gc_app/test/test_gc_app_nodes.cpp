@@ -27,6 +27,7 @@
 #include "gc_app/nodes/util/uint_size.hpp"
 #include "gc_app/nodes/visual/image_colorizer.hpp"
 #include "gc_app/nodes/visual/image_loader.hpp"
+#include "gc_app/nodes/visual/rect_view.hpp"
 #include "gc_app/types/cell2d_gen_cmap.hpp"
 #include "gc_app/types/cell2d_gen_rules.hpp"
 #include "gc_app/types/cell2d_rules.hpp"
@@ -39,11 +40,18 @@
 #include "gc/computation_context.hpp"
 #include "gc/computation_node.hpp"
 #include "gc/computation_node_registry.hpp"
+#include "gc/graph_computation.hpp"
 
 #include "mpk/mix/func_ref/func_ref.hpp"
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+
 
 using namespace gc_app;
 using namespace gc_types;
@@ -112,6 +120,86 @@ private:
     double longest_progress_delta_;
 };
 
+struct StopLatency final
+{
+    std::chrono::nanoseconds computation;
+    std::chrono::nanoseconds worst_stop;
+};
+
+// Computes `node` with stop requests at different times during
+// the computation, and measures the longest time from a stop request
+// to the return from `compute_outputs`, as well as the time of
+// an uninterrupted computation. Also checks that the node does not
+// compute when a stop is requested before the computation.
+auto measure_stop_latency(const gc::ComputationNode& node,
+                          const mpk::mix::value::ValueVec& inputs)
+    -> StopLatency
+{
+    using clock = std::chrono::steady_clock;
+    auto outputs = mpk::mix::value::ValueVec(node.output_count().v);
+
+    auto stopped = std::stop_source{};
+    stopped.request_stop();
+    EXPECT_FALSE(
+        node.compute_outputs(outputs, inputs, stopped.get_token(), {}));
+
+    auto start = clock::now();
+    EXPECT_TRUE(node.compute_outputs(outputs, inputs, {}, {}));
+    auto result = StopLatency{ .computation = clock::now() - start };
+
+    constexpr int stop_count = 8;
+    for (int i=0; i<stop_count; ++i)
+    {
+        auto stop_source = std::stop_source{};
+        auto stop_time = clock::time_point{};
+        auto delay = result.computation * i / stop_count;
+        auto stopper = std::jthread{ [&]
+        {
+            std::this_thread::sleep_for(delay);
+            stop_time = clock::now();
+            stop_source.request_stop();
+        } };
+        auto computed = node.compute_outputs(
+            outputs, inputs, stop_source.get_token(), {});
+        auto end = clock::now();
+        stopper.join();
+
+        // Stops requested after the computation has finished do not count
+        if (!computed)
+            result.worst_stop = std::max(
+                result.worst_stop,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    end - stop_time));
+    }
+    return result;
+}
+
+// Checks that `node` does not compute its outputs for `inputs` (large inputs
+// are expected) once a stop is requested, and records the stop latency
+// as test properties. Latencies are not compared against the computation
+// time, since both depend on the load of the machine running the tests.
+auto check_stop_latency(const gc::ComputationNode& node,
+                        const mpk::mix::value::ValueVec& inputs)
+    -> void
+{
+    using namespace std::chrono;
+    auto latency = measure_stop_latency(node, inputs);
+    ::testing::Test::RecordProperty(
+        "computation_us",
+        duration_cast<microseconds>(latency.computation).count());
+    ::testing::Test::RecordProperty(
+        "worst_stop_latency_us",
+        duration_cast<microseconds>(latency.worst_stop).count());
+}
+
+// Large image, so that computations take much longer
+// than the interval between checks for a stop request
+auto large_i8_image() -> I8Image
+{
+    constexpr Uint size = 4096;
+    return { .size = {size, size}, .data = std::vector<int8_t>(size*size, 0) };
+}
+
 auto make_computation_context() -> gc::ComputationContext
 {
     auto context = gc::ComputationContext{
@@ -429,6 +517,11 @@ TEST(GcApp_Node, Life)
 
     node->compute_outputs(outputs, inputs, {}, {});
     ASSERT_EQ(outputs[0].type(), mpk::mix::value::type_of<I8Image>());
+
+    // Output image of the same size is reused
+    const auto* output_pixels = outputs[0].as<I8Image>().data.data();
+    node->compute_outputs(outputs, inputs, {}, {});
+    EXPECT_EQ(outputs[0].as<I8Image>().data.data(), output_pixels);
 }
 
 TEST(GcApp_Node, OffsetImage)
@@ -527,6 +620,24 @@ TEST(GcApp_Node, RandomImage)
     }
     EXPECT_LT(n0, 2*n1);
     EXPECT_LT(n1, 2*n0);
+
+    // Invalid inputs leave the previous image intact
+    auto prev_data = img.data;
+    auto invalid_inputs = inputs;
+    invalid_inputs[0] = UintSize(0, 10);
+    EXPECT_THROW(node->compute_outputs(outputs, invalid_inputs, {}, {}),
+                 std::invalid_argument);
+    invalid_inputs = inputs;
+    invalid_inputs[3] = std::vector<int8_t>{ 1, 0, 2 };
+    EXPECT_THROW(node->compute_outputs(outputs, invalid_inputs, {}, {}),
+                 std::invalid_argument);
+    invalid_inputs = inputs;
+    invalid_inputs[4] = 10;
+    invalid_inputs[5] = std::string{"triangle"};
+    EXPECT_THROW(node->compute_outputs(outputs, invalid_inputs, {}, {}),
+                 std::invalid_argument);
+    EXPECT_EQ(outputs[0].as<I8Image>().size, UintSize(100, 100));
+    EXPECT_EQ(outputs[0].as<I8Image>().data, prev_data);
 }
 
 TEST(GcApp_Node, RuleReader)
@@ -589,6 +700,91 @@ TEST(GcApp_Node, ImageColorizer)
     EXPECT_EQ(image.data, expected_pixels);
 }
 
+TEST(GcApp_Node, FusedImageChain)
+{
+    auto graph = gc::ComputationGraph{
+        .nodes = { cell_aut::make_offset_image({}, {}),
+                   visual::make_image_colorizer({}, {}) },
+        .edges = { gc::edge({gc::NodeIndex{0}, 0_gc_o},
+                            {gc::NodeIndex{1}, 0_gc_i}) } };
+
+    auto plain = gc::computation(graph, {});
+    auto fused = gc::computation(graph, {}, { .fuse_elementwise = true });
+
+    // Source inputs are the input image and offset of the first node,
+    // then the palette and minimal state of the second one. The image
+    // spans several tiles of the fused chain.
+    auto input_image = I8Image{
+        .size = {200, 100},
+        .data = std::vector<int8_t>(200*100)
+    };
+    for (size_t i=0; i<input_image.data.size(); ++i)
+        input_image.data[i] = static_cast<int8_t>(i % 4) - 1;
+
+    auto check = [&]
+    {
+        ASSERT_TRUE(gc::compute_dirty(plain, {}, {}));
+        ASSERT_TRUE(gc::compute_dirty(fused, {}, {}));
+        const auto& expected =
+            group(plain.result.outputs, gc::NodeIndex{1})[0_gc_o]
+                .as<ColorImage>();
+        const auto& actual =
+            group(fused.result.outputs, gc::NodeIndex{1})[0_gc_o]
+                .as<ColorImage>();
+        EXPECT_EQ(actual.size, expected.size);
+        EXPECT_EQ(actual.data, expected.data);
+    };
+
+    for (auto* c : { &plain, &fused })
+        c->source_inputs.values[0] = input_image;
+    check();
+
+    for (auto* c : { &plain, &fused })
+        c->source_inputs.values[1] = int8_t{0};
+    check();
+
+    for (auto* c : { &plain, &fused })
+        c->source_inputs.values[3] = int8_t{-1};
+    check();
+}
+
+TEST(GcApp_Node, InPlaceImageChain)
+{
+    auto graph = gc::ComputationGraph{
+        .nodes = { cell_aut::make_offset_image({}, {}),
+                   cell_aut::make_offset_image({}, {}) },
+        .edges = { gc::edge({gc::NodeIndex{0}, 0_gc_o},
+                            {gc::NodeIndex{1}, 0_gc_i}) } };
+
+    auto plain = gc::computation(graph, {});
+    auto in_place = gc::computation(graph, {}, { .compute_in_place = true });
+
+    auto input_image = I8Image{
+        .size = {200, 100},
+        .data = std::vector<int8_t>(200*100)
+    };
+    for (size_t i=0; i<input_image.data.size(); ++i)
+        input_image.data[i] = static_cast<int8_t>(i % 4);
+
+    for (auto* c : { &plain, &in_place })
+    {
+        c->source_inputs.values[0] = input_image;
+        ASSERT_TRUE(gc::compute_dirty(*c, {}, {}));
+    }
+
+    // The second node transforms the output image of the first one
+    // in place, so that image is gone
+    const auto& expected =
+        group(plain.result.outputs, gc::NodeIndex{1})[0_gc_o].as<I8Image>();
+    const auto& actual =
+        group(in_place.result.outputs, gc::NodeIndex{1})[0_gc_o]
+            .as<I8Image>();
+    EXPECT_EQ(actual.size, expected.size);
+    EXPECT_EQ(actual.data, expected.data);
+    EXPECT_FALSE(
+        group(in_place.result.outputs, gc::NodeIndex{0})[0_gc_o].type());
+}
+
 TEST(GcApp_Node, ImageLoader)
 {
     auto node = visual::make_image_loader({}, {});
@@ -996,3 +1192,58 @@ TEST(GcApp_Progress, Waring)
 
     progress_checker.check();
 }
+
+// ---
+
+TEST(GcApp_Stop, Cell2d)
+{
+    auto node = cell_aut::make_cell2d({}, {});
+    auto inputs = mpk::mix::value::ValueVec(2);
+    node->default_inputs(inputs);
+    inputs[1] = large_i8_image();
+    check_stop_latency(*node, inputs);
+}
+
+TEST(GcApp_Stop, Life)
+{
+    auto node = cell_aut::make_life({}, {});
+    auto inputs = mpk::mix::value::ValueVec{ large_i8_image() };
+    check_stop_latency(*node, inputs);
+}
+
+TEST(GcApp_Stop, ImageColorizer)
+{
+    auto node = visual::make_image_colorizer({}, {});
+    auto inputs = mpk::mix::value::ValueVec(3);
+    node->default_inputs(inputs);
+    inputs[0] = large_i8_image();
+    check_stop_latency(*node, inputs);
+}
+
+TEST(GcApp_Stop, OffsetImage)
+{
+    auto node = cell_aut::make_offset_image({}, {});
+    auto inputs = mpk::mix::value::ValueVec(2);
+    node->default_inputs(inputs);
+    inputs[0] = large_i8_image();
+    check_stop_latency(*node, inputs);
+}
+
+TEST(GcApp_Stop, FilterSeq)
+{
+    auto node = num::make_filter_seq({}, {});
+    auto inputs = mpk::mix::value::ValueVec(2);
+    inputs[0] = uint_vec_val(UintVec(Uint{1} << 24, 0));
+    inputs[1] = uint_val(1);
+    check_stop_latency(*node, inputs);
+}
+
+TEST(GcApp_Stop, RectView)
+{
+    auto node = visual::make_rect_view({}, {});
+    auto inputs = mpk::mix::value::ValueVec(3);
+    node->default_inputs(inputs);
+    inputs[0] = UintSize(4096, 4096);
+    inputs[1] = UintVec(Uint{1} << 24, 0);
+    check_stop_latency(*node, inputs);
+}
@@ -8,26 +8,585 @@
  * @author Stepan Orlov <majorsteve@mail.ru>
  */
 
+#include "common/thread_pool.hpp"
+
+#include "mpk/mix/serial/yaml/parse_value.hpp"
 #include "mpk/mix/util/throw.hpp"
 
 #include "gc_app/node_registry.hpp"
 #include "gc_app/type_registry.hpp"
+#include "gc_app/value_fingerprint.hpp"
+
+#include "gc_types/snapshot_codecs.hpp"
+#include "gc_types/value_size.hpp"
 
 #include "gc/computation_context.hpp"
 #include "gc/computation_node_registry.hpp"
+#include "gc/computation_profile.hpp"
+#include "gc/detail/computation_node_indices.hpp"
+#include "gc/detail/parse_node_port.hpp"
+#include "gc/disk_cache.hpp"
+#include "gc/generate_dot.hpp"
 #include "gc/graph_computation.hpp"
+#include "gc/graph_evolution.hpp"
+#include "gc/parameter_sweep.hpp"
+#include "gc/pipelined_evolution.hpp"
+#include "gc/snapshot.hpp"
 #include "gc/yaml/parse_graph.hpp"
+#include "gc/yaml/parse_graph_evolution.hpp"
 
 #include <yaml-cpp/yaml.h>
 
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <optional>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+constexpr auto usage =
+    "Usage: gc_cli [--threads N] [--fuse] [--cutoff] [--plan-memory]"
+    " [--in-place]"
+    " [--cache-dir DIR [--cache-size MiB]]"
+    " [--profile] [--profile-json FILE] [--profile-dot FILE]"
+    " [--request OUTPUT ...]"
+    " [--sweep FILE | --steps N [--pipeline QUEUE_SIZE]"
+    " [--emit OUTPUT ...] [--emit-every K]]"
+    " [--restore FILE] [--snapshot FILE [--snapshot-every K]]"
+    " gc-file";
+
+constexpr uint64_t default_cache_size = 1024;
+
+struct CliOptions final
+{
+    std::string gc_file;
+
+    // If set, the graph is computed by the dataflow executor
+    // on a thread pool with the specified number of threads
+    // (zero means the number of hardware threads).
+    std::optional<size_t> thread_count;
+
+    // If set, chains of elementwise nodes are fused
+    // (see `CompileOptions::fuse_elementwise`)
+    bool fuse = false;
+
+    // If set, consumers of nodes recomputed with unchanged outputs
+    // are not recomputed (see `ComputationResult::fingerprint`)
+    bool cutoff = false;
+
+    // If set, intermediate outputs are released as soon as they are
+    // consumed (see `CompileOptions::plan_memory`)
+    bool plan_memory = false;
+
+    // If set, nodes with in-place ports transform upstream outputs
+    // no one else uses (see `CompileOptions::compute_in_place`)
+    bool in_place = false;
+
+    // If not empty, outputs of expensive nodes are stored in
+    // the persistent cache in this directory.
+    std::string cache_dir;
+
+    // Persistent cache capacity, MiB
+    uint64_t cache_size = default_cache_size;
+
+    // If not empty, only nodes these outputs (node.port) depend on are
+    // computed, along with outputs emitted or fed back during evolution
+    std::vector<std::string> request;
+
+    // If set, a table with per-node statistics is printed
+    bool profile = false;
+
+    // If not empty, per-node statistics are written to these files
+    // in the JSON and DOT formats
+    std::string profile_json_file;
+    std::string profile_dot_file;
+
+    // If not empty, the graph is computed for each combination of source
+    // input values listed in this YAML file, e.g.,
+    //   - name: waring_s
+    //     values: [2, 3, 4]
+    //   - name: seq_size
+    //     values: [1000, 10000]
+    std::string sweep_file;
+
+    // If positive, the graph is computed and then evolved by this number
+    // of steps according to the `evolution` section of the graph file
+    size_t steps = 0;
+
+    // Node outputs (node.port) printed during evolution: every `emit_every`
+    // steps, or after the last step if `emit_every` is zero
+    std::vector<std::string> emit;
+    size_t emit_every = 0;
+
+    // If positive, evolution steps are pipelined (see `evolve_pipelined`),
+    // with at most this number of steps queued for post-processing
+    size_t pipeline = 0;
+
+    // If not empty, the state of the computation is restored from this
+    // snapshot file before computing, and evolution continues from
+    // the step of the snapshot
+    std::string restore_file;
+
+    // If not empty, the state of the computation is saved to this file
+    // when finished, and, during evolution, every `snapshot_every` steps
+    // if it is positive (steps must not be pipelined then). Snapshots
+    // taken during evolution are written in the background.
+    std::string snapshot_file;
+    size_t snapshot_every = 0;
+
+    auto profiling() const noexcept -> bool
+    {
+        return profile ||
+               !profile_json_file.empty() ||
+               !profile_dot_file.empty();
+    }
+};
+
+auto parse_options(int argc, char* argv[])
+    -> CliOptions
+{
+    auto result = CliOptions{};
+    for (int i=1; i<argc; ++i)
+    {
+        auto arg = std::string_view{ argv[i] };
+        if (arg == "--threads")
+        {
+            if (++i == argc)
+                mpk::mix::throw_("{}", usage);
+            result.thread_count = std::stoul(argv[i]);
+        }
+        else if (arg == "--fuse")
+            result.fuse = true;
+        else if (arg == "--cutoff")
+            result.cutoff = true;
+        else if (arg == "--plan-memory")
+            result.plan_memory = true;
+        else if (arg == "--in-place")
+            result.in_place = true;
+        else if (arg == "--cache-dir")
+        {
+            if (++i == argc)
+                mpk::mix::throw_("{}", usage);
+            result.cache_dir = argv[i];
+        }
+        else if (arg == "--cache-size")
+        {
+            if (++i == argc)
+                mpk::mix::throw_("{}", usage);
+            result.cache_size = std::stoull(argv[i]);
+        }
+        else if (arg == "--request")
+        {
+            if (++i == argc)
+                mpk::mix::throw_("{}", usage);
+            result.request.push_back(argv[i]);
+        }
+        else if (arg == "--profile")
+            result.profile = true;
+        else if (arg == "--profile-json")
+        {
+            if (++i == argc)
+                mpk::mix::throw_("{}", usage);
+            result.profile_json_file = argv[i];
+        }
+        else if (arg == "--profile-dot")
+        {
+            if (++i == argc)
+                mpk::mix::throw_("{}", usage);
+            result.profile_dot_file = argv[i];
+        }
+        else if (arg == "--sweep")
+        {
+            if (++i == argc)
+                mpk::mix::throw_("{}", usage);
+            result.sweep_file = argv[i];
+        }
+        else if (arg == "--steps")
+        {
+            if (++i == argc)
+                mpk::mix::throw_("{}", usage);
+            result.steps = std::stoull(argv[i]);
+        }
+        else if (arg == "--pipeline")
+        {
+            if (++i == argc)
+                mpk::mix::throw_("{}", usage);
+            result.pipeline = std::stoull(argv[i]);
+        }
+        else if (arg == "--emit")
+        {
+            if (++i == argc)
+                mpk::mix::throw_("{}", usage);
+            result.emit.push_back(argv[i]);
+        }
+        else if (arg == "--emit-every")
+        {
+            if (++i == argc)
+                mpk::mix::throw_("{}", usage);
+            result.emit_every = std::stoull(argv[i]);
+        }
+        else if (arg == "--restore")
+        {
+            if (++i == argc)
+                mpk::mix::throw_("{}", usage);
+            result.restore_file = argv[i];
+        }
+        else if (arg == "--snapshot")
+        {
+            if (++i == argc)
+                mpk::mix::throw_("{}", usage);
+            result.snapshot_file = argv[i];
+        }
+        else if (arg == "--snapshot-every")
+        {
+            if (++i == argc)
+                mpk::mix::throw_("{}", usage);
+            result.snapshot_every = std::stoull(argv[i]);
+        }
+        else if (result.gc_file.empty())
+            result.gc_file = arg;
+        else
+            mpk::mix::throw_("{}", usage);
+    }
+
+    if (result.gc_file.empty())
+        mpk::mix::throw_("{}", usage);
+
+    if (!result.sweep_file.empty() &&
+        (result.steps > 0 ||
+         !result.restore_file.empty() ||
+         !result.snapshot_file.empty()))
+        mpk::mix::throw_("{}", usage);
+
+    // Results passed on by pipelined steps lack outputs of some nodes
+    if (result.snapshot_every > 0 && result.pipeline > 0)
+        mpk::mix::throw_("{}", usage);
+
+    // Pipelined steps are computed by the loop and post-processing
+    // threads, not by a thread pool
+    if (result.thread_count && result.pipeline > 0)
+        mpk::mix::throw_("--threads cannot be combined with --pipeline");
+
+    // Released outputs are recomputed by each computation, so every step
+    // would compute the whole graph, defeating incremental steps
+    if (result.plan_memory && result.steps > 0)
+        mpk::mix::throw_(
+            "--plan-memory cannot be combined with --steps: released "
+            "outputs would be recomputed by each step, disabling "
+            "incremental steps, folding of static nodes and --cutoff");
+
+    // Same for outputs taken over by nodes computed in place
+    if (result.in_place && result.steps > 0)
+        mpk::mix::throw_(
+            "--in-place cannot be combined with --steps: outputs taken "
+            "over in place would be recomputed by each step, disabling "
+            "incremental steps, folding of static nodes and --cutoff");
+
+    return result;
+}
+
+auto write_file(const std::string& file_name, const auto& write)
+    -> void
+{
+    auto s = std::ofstream(file_name);
+    if (!s.is_open())
+        mpk::mix::throw_("Failed to open output file '{}'", file_name);
+    write(s);
+}
+
+auto print_profile(const CliOptions& options,
+                   const YAML::Node& graph_config,
+                   const gc::ComputationGraph& g,
+                   const gc::ComputationProfile& profile)
+    -> void
+{
+    // Label nodes with their names and types
+    auto label_storage = std::vector<std::string>{};
+    for (auto node : graph_config["nodes"])
+        label_storage.push_back(
+            node["name"].as<std::string>() +
+            " (" + node["type"].as<std::string>() + ")");
+    assert(label_storage.size() == g.nodes.size().v);
+    auto labels = std::vector<std::string_view>(
+        label_storage.begin(), label_storage.end());
+
+    if (options.profile)
+        gc::print_profile_table(std::cout, profile, labels);
+
+    if (!options.profile_json_file.empty())
+        write_file(options.profile_json_file,
+                   [&](std::ostream& s)
+                   { gc::print_profile_json(s, profile, labels); });
+
+    if (!options.profile_dot_file.empty())
+        write_file(options.profile_dot_file,
+                   [&](std::ostream& s)
+                   { gc::generate_dot(s, g, labels, profile); });
+}
+
+auto parse_sweep(const std::string& sweep_file,
+                 const gc::SourceInputs& source_inputs,
+                 const std::vector<std::string>& input_names,
+                 const gc::TypeRegistry& type_registry)
+    -> std::vector<gc::SweepParameter>
+{
+    auto result = std::vector<gc::SweepParameter>{};
+    for (auto item : YAML::LoadFile(sweep_file))
+    {
+        auto name = item["name"].as<std::string>();
+        auto it = std::ranges::find(input_names, name);
+        if (it == input_names.end())
+            mpk::mix::throw_(
+                "Sweep file '{}' refers to unknown source input '{}'",
+                sweep_file, name);
+        auto index = static_cast<size_t>(it - input_names.begin());
+
+        const auto* type = source_inputs.values.at(index).type();
+        auto values = mpk::mix::value::ValueVec{};
+        for (auto value : item["values"])
+            values.push_back(
+                mpk::mix::serial::yaml::parse_value(
+                    value, type, type_registry));
+
+        result.push_back({ .index = index, .values = std::move(values) });
+    }
+    return result;
+}
+
+auto run_sweep(const CliOptions& options,
+               gc::Computation& c,
+               const std::vector<std::string>& input_names,
+               const gc::TypeRegistry& type_registry)
+    -> void
+{
+    auto parameters = parse_sweep(
+        options.sweep_file, c.source_inputs, input_names, type_registry);
+    auto variants = gc::sweep_variants(parameters);
+
+    auto pool = common::ThreadPool{ options.thread_count.value_or(0) };
+
+    auto start_time = std::chrono::steady_clock::now();
+    auto handle_result =
+        [&](size_t ivariant, const gc::ComputationResult&)
+    {
+        auto dt = std::chrono::nanoseconds{
+            std::chrono::steady_clock::now() - start_time }.count() / 1e9;
+
+        std::cout << "Variant " << ivariant << " finished (";
+        auto delim = "";
+        for (const auto& in : variants[ivariant].inputs)
+        {
+            std::cout
+                << delim << input_names[in.index] << ": " << in.value;
+            delim = ", ";
+        }
+        std::cout << "), time elapsed: " << dt << std::endl;
+    };
+
+    gc::compute_sweep(c, variants, handle_result, {}, pool);
+}
+
+// Returns the element of sorted `values` at the percentile `p`
+auto percentile(const std::vector<std::chrono::nanoseconds>& sorted_values,
+                double p)
+    -> double
+{
+    assert(!sorted_values.empty());
+    auto n = sorted_values.size();
+    auto index = std::min(static_cast<size_t>(p / 100 * n), n - 1);
+    return sorted_values[index].count() / 1e9;
+}
+
+auto parse_outputs(
+    const std::vector<std::string>& names,
+    const gc::ComputationGraph& g,
+    const gc::detail::NamedNodes<gc::ComputationNode>& node_map)
+    -> std::vector<gc::EdgeOutputEnd>
+{
+    auto node_indices = gc::detail::ComputationNodeIndices{};
+    for (auto inode : g.nodes.index_range())
+        node_indices.emplace(g.nodes[inode].get(), inode);
+    auto result = std::vector<gc::EdgeOutputEnd>{};
+    for (const auto& name : names)
+        result.push_back(
+            gc::detail::parse_node_port(name, node_map, node_indices,
+                                        gc::Output));
+    return result;
+}
+
+// Returns the evolution of the graph if it is to be evolved
+auto parse_evolution(
+    const CliOptions& options,
+    const YAML::Node& config,
+    const gc::ComputationGraph& g,
+    const gc::detail::NamedNodes<gc::ComputationNode>& node_map)
+    -> std::optional<gc::GraphEvolution>
+{
+    if (options.steps == 0)
+        return std::nullopt;
+
+    auto evolution_config = config["evolution"];
+    if (!evolution_config)
+        mpk::mix::throw_("Graph file '{}' has no evolution section",
+                         options.gc_file);
+    return gc::yaml::parse_graph_evolution(evolution_config, g, node_map);
+}
+
+// Returns outputs the run needs: the ones requested with --request,
+// and the ones emitted or fed back during evolution
+auto used_outputs(
+    const CliOptions& options,
+    const std::optional<gc::GraphEvolution>& evolution,
+    const gc::ComputationGraph& g,
+    const gc::detail::NamedNodes<gc::ComputationNode>& node_map)
+    -> std::vector<gc::EdgeOutputEnd>
+{
+    auto result = parse_outputs(options.request, g, node_map);
+    if (!evolution)
+        return result;
+
+    std::ranges::copy(parse_outputs(options.emit, g, node_map),
+                      std::back_inserter(result));
+    for (const auto& fb : evolution->feedback)
+        result.push_back(fb.source);
+    return result;
+}
+
+// Returns inputs set by evolution feedback
+auto feedback_sinks(const std::optional<gc::GraphEvolution>& evolution)
+    -> std::vector<gc::EdgeInputEnd>
+{
+    auto result = std::vector<gc::EdgeInputEnd>{};
+    if (evolution)
+        for (const auto& fb : evolution->feedback)
+            std::ranges::copy(fb.sinks, std::back_inserter(result));
+    return result;
+}
+
+auto run_evolution(
+    const CliOptions& options,
+    gc::Computation& c,
+    const gc::GraphEvolution& evolution,
+    const gc::detail::NamedNodes<gc::ComputationNode>& node_map,
+    size_t first_step,
+    const gc::SnapshotCodecs& codecs,
+    std::string_view graph_id)
+    -> void
+{
+    auto emitted_outputs = parse_outputs(options.emit, c.graph, node_map);
+    auto last_step = first_step + options.steps;
+
+    auto emit = [&](size_t step, const gc::ComputationResult& result)
+    {
+        auto emitted =
+            options.emit_every == 0
+                ? step == last_step
+                : step % options.emit_every == 0;
+        if (!emitted)
+            return;
+
+        for (size_t i=0, n=emitted_outputs.size(); i<n; ++i)
+        {
+            auto [node, port] = emitted_outputs[i];
+            std::cout
+                << "Step " << step << ", " << options.emit[i] << ": "
+                << group(result.outputs, node)[port] << std::endl;
+        }
+    };
+
+    // Snapshots are taken between steps and written in the background
+    auto snapshot_writer = std::optional<gc::SnapshotWriter>{};
+    if (!options.snapshot_file.empty())
+        snapshot_writer.emplace(options.snapshot_file, codecs);
+
+    auto pool = std::optional<common::ThreadPool>{};
+    if (options.thread_count)
+        pool.emplace(*options.thread_count);
+    auto compute_step = [&]
+    {
+        if (pool)
+            compute(c, {}, {}, *pool);
+        else
+            compute_dirty(c, {}, {});
+    };
+
+    // Compute initial state
+    compute_step();
+
+    auto step_times = std::vector<std::chrono::nanoseconds>{};
+    step_times.reserve(options.steps);
+    if (options.pipeline > 0)
+    {
+        // Steps overlap, so step times are intervals between finished steps
+        auto last_time = std::chrono::steady_clock::now();
+        auto handle_step =
+            [&](size_t step, const gc::ComputationResult& result)
+        {
+            auto time = std::chrono::steady_clock::now();
+            step_times.push_back(time - last_time);
+            last_time = time;
+            emit(first_step + step, result);
+        };
+        // Emitted outputs of loop nodes are passed to `handle_step`
+        // along with the ones post-processing consumes
+        gc::evolve_pipelined(
+            c, evolution, options.steps, options.pipeline, handle_step, {},
+            emitted_outputs);
+    }
+    else
+    {
+        for (auto step=first_step+1; step<=last_step; ++step)
+        {
+            auto start_time = std::chrono::steady_clock::now();
+            gc::set_feedback(c.result, evolution);
+            compute_step();
+            if (snapshot_writer &&
+                options.snapshot_every > 0 &&
+                step % options.snapshot_every == 0 &&
+                step != last_step)
+                snapshot_writer->save(gc::take_snapshot(c, step, graph_id));
+            step_times.push_back(
+                std::chrono::steady_clock::now() - start_time);
+            emit(step, c.result);
+        }
+        gc::clear_feedback(c.result);
+    }
+
+    if (snapshot_writer)
+    {
+        snapshot_writer->save(gc::take_snapshot(c, last_step, graph_id));
+        snapshot_writer->flush();
+        if (auto error = snapshot_writer->error(); !error.empty())
+            mpk::mix::throw_("{}", error);
+    }
+
+    auto total_time = std::chrono::nanoseconds{};
+    for (auto t : step_times)
+        total_time += t;
+    std::ranges::sort(step_times);
+
+    std::cout
+        << "Evolution finished, steps: " << options.steps
+        << ", steps/s: " << options.steps / (total_time.count() / 1e9)
+        << ", step time p50: " << percentile(step_times, 50)
+        << ", p90: " << percentile(step_times, 90)
+        << ", p99: " << percentile(step_times, 99)
+        << ", max: " << step_times.back().count() / 1e9 << std::endl;
+}
+
+} // anonymous namespace
 
 auto run(int argc, char* argv[])
     -> void
 {
-    if (argc != 2)
-        mpk::mix::throw_("Usage: gc_cli gc-file");
+    auto options = parse_options(argc, argv);
 
     // Initialize node registry and type registry
     auto context = gc::ComputationContext{
@@ -38,17 +597,73 @@ auto run(int argc, char* argv[])
     gc_app::populate_type_registry(context.type_registry);
 
     // Load graph from the YAML file
-    auto config = YAML::LoadFile(argv[1]);
+    auto config = YAML::LoadFile(options.gc_file);
 
     // Parse graph from the node object.
     auto graph_config = config["graph"];
     auto [g, provided_inputs, node_map, input_names] =
         gc::yaml::parse_graph(graph_config, context);
 
-    auto c = computation(g, provided_inputs);
+    auto evolution = parse_evolution(options, config, g, node_map);
+
+    // Outputs used by the run are neither fused nor skipped; nodes
+    // not depending on feedback are folded out of evolution steps.
+    auto outputs = used_outputs(options, evolution, g, node_map);
+    auto c = computation(
+        g,
+        provided_inputs,
+        { .fuse_elementwise = options.fuse,
+          .keep_outputs = outputs,
+          .variable_inputs = feedback_sinks(evolution),
+          .plan_memory = options.plan_memory,
+          .compute_in_place = options.in_place });
+    if (const auto* plan = gc::memory_plan(*c.instr))
+        std::cout << "Memory plan: " << *plan << std::endl;
+    if (!options.request.empty())
+        request_outputs(c, outputs);
+    if (options.cutoff)
+        c.result.fingerprint = gc_app::value_fingerprint;
+    if (!options.cache_dir.empty())
+        c.result.disk_cache = std::make_shared<gc::DiskCache>(
+            options.cache_dir, options.cache_size << 20);
+
+    if (options.profiling())
+        c.result.profile = std::make_shared<gc::ComputationProfile>(
+            gc::ComputationProfile{ .value_size = gc_types::value_size });
+
+    auto snapshot_codecs = gc::SnapshotCodecs{};
+    gc_types::add_snapshot_codecs(snapshot_codecs);
+    // Snapshots are only restored for the same graph definition
+    auto graph_id = YAML::Dump(graph_config);
+    auto first_step = size_t{};
+    if (!options.restore_file.empty())
+    {
+        first_step = gc::restore_snapshot(
+            c, options.restore_file, snapshot_codecs, graph_id);
+        std::cout
+            << "Restored snapshot '" << options.restore_file
+            << "', step: " << first_step << std::endl;
+    }
 
     auto start_time = std::chrono::steady_clock::now();
-    compute(c);
+    if (!options.sweep_file.empty())
+        run_sweep(options, c, input_names, context.type_registry);
+    else if (options.steps > 0)
+        run_evolution(options, c, *evolution, node_map,
+                      first_step, snapshot_codecs, graph_id);
+    else
+    {
+        if (options.thread_count)
+        {
+            auto pool = common::ThreadPool{ *options.thread_count };
+            compute(c, {}, {}, pool);
+        }
+        else
+            compute(c);
+        if (!options.snapshot_file.empty())
+            gc::save_snapshot(options.snapshot_file, c,
+                              first_step, snapshot_codecs, graph_id);
+    }
     auto end_time = std::chrono::steady_clock::now();
 
     auto dt =
@@ -58,6 +673,15 @@ auto run(int argc, char* argv[])
         << "Computation finished"
            ", pid: " << getpid()
         << ", time elapsed: " << dt << std::endl;
+
+    if (const auto& cache = c.result.disk_cache)
+        std::cout
+            << "Persistent cache hits: " << cache->hit_count()
+            << ", misses: " << cache->miss_count()
+            << ", size: " << cache->size() << std::endl;
+
+    if (c.result.profile)
+        print_profile(options, graph_config, c.graph, *c.result.profile);
 }
 
 auto main(int argc, char* argv[])
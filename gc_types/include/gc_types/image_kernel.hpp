@@ -0,0 +1,51 @@
+/** @file
+ * @brief Elementwise kernels of nodes transforming images pixel by pixel.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include "gc_types/image.hpp"
+#include "gc_types/output_image.hpp"
+
+#include "gc/elementwise_kernel.hpp"
+
+#include <cstddef>
+#include <span>
+
+
+namespace gc_types {
+
+// Returns the kernel of a node computing each pixel of the output image
+// as `f(p)`, where `p` is the pixel of the input image at the same position.
+template <typename InPixel, typename OutPixel, typename F>
+auto image_kernel(F f) -> gc::ElementwiseKernel
+{
+    using Value = mpk::mix::value::Value;
+    return {
+        .input_element_size = sizeof(InPixel),
+        .output_element_size = sizeof(OutPixel),
+        .apply = [f](const std::byte* input, std::byte* output, size_t count)
+        {
+            const auto* in = reinterpret_cast<const InPixel*>(input);
+            auto* out = reinterpret_cast<OutPixel*>(output);
+            for (size_t i=0; i<count; ++i)
+                out[i] = f(in[i]);
+        },
+        .input_elements = [](const Value& input, Value& shape)
+        {
+            const auto& image = input.as<Image<InPixel>>();
+            shape = image.size;
+            return std::as_bytes(std::span{ image.data });
+        },
+        .output_elements = [](Value& output, const Value& shape)
+        {
+            auto& image = output_image<OutPixel>(output, shape.as<UintSize>());
+            return std::as_writable_bytes(std::span{ image.data });
+        } };
+}
+
+} // namespace gc_types
@@ -0,0 +1,50 @@
+/** @file
+ * @brief Reuse of images produced by nodes between computations.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include "gc_types/image.hpp"
+
+#include "gc/output_slot.hpp"
+
+
+namespace gc_types {
+
+// Returns the image of the specified size held by the node output `out`.
+// The image is the output of the previous computation, if it has the same
+// size and pixel type; otherwise, it is a new image with zero pixels.
+template <typename Pixel>
+auto output_image(mpk::mix::value::Value& out, const UintSize& size)
+    -> Image<Pixel>&
+{
+    return gc::output_slot<Image<Pixel>>(
+        out,
+        [&](const Image<Pixel>& image) { return image.size == size; },
+        [&]
+        {
+            return Image<Pixel>{
+                .size = size,
+                .data = std::vector<Pixel>(size_t{size.width} * size.height)
+            };
+        });
+}
+
+// Same as above, except that the size is that of `prototype`,
+// and the new image is a copy of `prototype`.
+template <typename Pixel>
+auto output_image(mpk::mix::value::Value& out, const Image<Pixel>& prototype)
+    -> Image<Pixel>&
+{
+    return gc::output_slot<Image<Pixel>>(
+        out,
+        [&](const Image<Pixel>& image)
+        { return image.size == prototype.size; },
+        [&] { return prototype; });
+}
+
+} // namespace gc_types
@@ -0,0 +1,22 @@
+/** @file
+ * @brief Snapshot codecs of values of gc_types.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include "gc/snapshot.hpp"
+
+
+namespace gc_types {
+
+// Registers codecs of image sizes, images, and vectors of colors
+// (see `gc::SnapshotCodecs`). Pixels of an image are its payload,
+// so they are stored page-aligned.
+auto add_snapshot_codecs(gc::SnapshotCodecs& codecs)
+    -> void;
+
+} // namespace gc_types
@@ -0,0 +1,24 @@
+/** @file
+ * @brief Hashes of values of gc_types used to detect unchanged node outputs.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include "mpk/mix/value/value_fwd.hpp"
+
+#include <cstdint>
+
+
+namespace gc_types {
+
+// Returns the hash of a value of an arithmetic type, a string, an image
+// size, an image, or a vector of pixels, colors, or integers; returns zero
+// for values of other types (see `gc::ValueFingerprint`).
+auto value_fingerprint(const mpk::mix::value::Value& value)
+    -> uint64_t;
+
+} // namespace gc_types
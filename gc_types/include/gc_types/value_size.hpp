@@ -0,0 +1,23 @@
+/** @file
+ * @brief Estimation of memory occupied by values of gc_types.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#pragma once
+
+#include "mpk/mix/value/value_fwd.hpp"
+
+#include <cstddef>
+
+
+namespace gc_types {
+
+// Returns the size of the value object plus the size of pixel data for
+// images, and of element data for vectors of pixels and colors.
+auto value_size(const mpk::mix::value::Value& value)
+    -> size_t;
+
+} // namespace gc_types
@@ -0,0 +1,85 @@
+/** @file
+ * @brief Snapshot codecs of values of gc_types.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "gc_types/snapshot_codecs.hpp"
+
+#include "gc_types/image.hpp"
+
+#include "mpk/mix/util/throw.hpp"
+#include "mpk/mix/value/type.hpp"
+#include "mpk/mix/value/value.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace gc_types {
+
+namespace {
+
+using Bytes = gc::SnapshotCodecs::Bytes;
+using Value = mpk::mix::value::Value;
+
+// The header is the image size, and the payload is pixels
+template <typename Pixel>
+auto image_codec(std::string name)
+    -> gc::SnapshotCodecs::Codec
+{
+    using I = Image<Pixel>;
+    return {
+        .name = std::move(name),
+        .type = mpk::mix::value::type_of<I>(),
+        .encode = [](const Value& value, std::string& header) -> Bytes
+        {
+            const auto& image = value.as<I>();
+            header.append(reinterpret_cast<const char*>(&image.size),
+                          sizeof(image.size));
+            return std::as_bytes(std::span{ image.data });
+        },
+        .decode = [](Bytes header, Bytes payload) -> Value
+        {
+            auto image = I{};
+            if (header.size() != sizeof(image.size))
+                mpk::mix::throw_<std::invalid_argument>(
+                    "Image header size {} does not match size {}",
+                    header.size(), sizeof(image.size));
+            std::memcpy(&image.size, header.data(), sizeof(image.size));
+            auto pixel_count =
+                uint64_t{ image.size.width } * image.size.height;
+            if (payload.size() != pixel_count * sizeof(Pixel))
+                mpk::mix::throw_<std::invalid_argument>(
+                    "Image payload size {} does not match image size {}x{}",
+                    payload.size(), image.size.width, image.size.height);
+            image.data.resize(pixel_count);
+            std::memcpy(image.data.data(), payload.data(), payload.size());
+            return image;
+        } };
+}
+
+} // anonymous namespace
+
+auto add_snapshot_codecs(gc::SnapshotCodecs& codecs)
+    -> void
+{
+    using C = gc::SnapshotCodecs;
+    codecs.add_codec(C::trivial_codec<UintSize>("UintSize"));
+    codecs.add_codec(C::trivial_codec<ColorVec>("Color[]"));
+    codecs.add_codec(image_codec<Color>("ColorImage"));
+    codecs.add_codec(image_codec<int8_t>("I8Image"));
+    codecs.add_codec(image_codec<uint8_t>("U8Image"));
+    codecs.add_codec(image_codec<int16_t>("I16Image"));
+    codecs.add_codec(image_codec<uint16_t>("U16Image"));
+    codecs.add_codec(image_codec<int32_t>("I32Image"));
+    codecs.add_codec(image_codec<uint32_t>("U32Image"));
+}
+
+} // namespace gc_types
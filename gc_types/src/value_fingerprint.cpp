@@ -0,0 +1,93 @@
+/** @file
+ * @brief Hashes of values of gc_types used to detect unchanged node outputs.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "gc_types/value_fingerprint.hpp"
+
+#include "gc_types/image.hpp"
+
+#include "gc/value_fingerprint.hpp"
+
+#include "mpk/mix/value/type.hpp"
+#include "mpk/mix/value/value.hpp"
+
+#include <string>
+#include <vector>
+
+
+namespace gc_types {
+
+namespace {
+
+using mpk::mix::value::Value;
+using mpk::mix::value::type_of;
+
+template <typename... T>
+auto add_scalar(gc::Fingerprint& fingerprint, const Value& value)
+    -> bool
+{
+    auto add = [&]<typename U>()
+    {
+        if (value.type() != type_of<U>())
+            return false;
+        fingerprint.add(value.as<U>());
+        return true;
+    };
+    return (add.template operator()<T>() || ...);
+}
+
+template <typename... Pixel>
+auto add_data(gc::Fingerprint& fingerprint, const Value& value)
+    -> bool
+{
+    auto add = [&]<typename P>()
+    {
+        if (value.type() == type_of<Image<P>>())
+        {
+            const auto& image = value.as<Image<P>>();
+            fingerprint
+                .add(image.size)
+                .add_values(std::span<const P>{ image.data });
+        }
+        else if (value.type() == type_of<std::vector<P>>())
+            fingerprint.add_values(
+                std::span<const P>{ value.as<std::vector<P>>() });
+        else
+            return false;
+        return true;
+    };
+    return (add.template operator()<Pixel>() || ...);
+}
+
+} // anonymous namespace
+
+auto value_fingerprint(const mpk::mix::value::Value& value)
+    -> uint64_t
+{
+    auto fingerprint = gc::Fingerprint{};
+
+    // Tell apart equal bytes of values of different types
+    fingerprint.add(static_cast<const void*>(value.type()));
+
+    auto known =
+        add_scalar<bool, int8_t, uint8_t, int16_t, uint16_t,
+                   int32_t, uint32_t, int64_t, uint64_t,
+                   float, double, UintSize>(fingerprint, value) ||
+        add_data<Color, int8_t, uint8_t,
+                 int16_t, uint16_t, int32_t, uint32_t>(fingerprint, value);
+
+    if (!known && value.type() == type_of<std::string>())
+    {
+        const auto& s = value.as<std::string>();
+        fingerprint.add_bytes(s.data(), s.size());
+        known = true;
+    }
+
+    return known ? fingerprint.value() : 0;
+}
+
+} // namespace gc_types
@@ -0,0 +1,52 @@
+/** @file
+ * @brief Estimation of memory occupied by values of gc_types.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "gc_types/value_size.hpp"
+
+#include "gc_types/image.hpp"
+
+#include "mpk/mix/value/type.hpp"
+#include "mpk/mix/value/value.hpp"
+
+
+namespace gc_types {
+
+namespace {
+
+template <typename... Pixel>
+auto data_size(const mpk::mix::value::Value& value)
+    -> size_t
+{
+    using mpk::mix::value::type_of;
+
+    auto result = size_t{};
+    auto add_size = [&]<typename P>()
+    {
+        if (value.type() == type_of<Image<P>>())
+            result = value.as<Image<P>>().data.size() * sizeof(P);
+        else if (value.type() == type_of<std::vector<P>>())
+            result = value.as<std::vector<P>>().size() * sizeof(P);
+        else
+            return false;
+        return true;
+    };
+    (add_size.template operator()<Pixel>() || ...);
+    return result;
+}
+
+} // anonymous namespace
+
+auto value_size(const mpk::mix::value::Value& value)
+    -> size_t
+{
+    return sizeof(mpk::mix::value::Value) +
+           data_size<Color, int8_t, uint8_t,
+                     int16_t, uint16_t, int32_t, uint32_t>(value);
+}
+
+} // namespace gc_types
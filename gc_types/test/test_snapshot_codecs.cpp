@@ -0,0 +1,70 @@
+/** @file
+ * @brief Tests of snapshot codecs of gc_types values.
+ *
+ * Copyright (C) 2026 MPK Software, St.-Petersburg, Russia
+ *
+ * @author Stepan Orlov <majorsteve@mail.ru>
+ */
+
+#include "gc_types/snapshot_codecs.hpp"
+
+#include "gc_types/image.hpp"
+
+#include "mpk/mix/value/type.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+
+using namespace gc_types;
+
+TEST(GcTypes, SnapshotCodecs)
+{
+    auto codecs = gc::SnapshotCodecs{};
+    add_snapshot_codecs(codecs);
+
+    auto image = I16Image{
+        .size = { .width = 3, .height = 2 },
+        .data = { 1, -2, 3, -4, 5, -6 } };
+    auto value = mpk::mix::value::Value{ image };
+
+    const auto* codec = codecs.find(value.type());
+    ASSERT_NE(codec, nullptr);
+    EXPECT_EQ(codecs.find(codec->name), codec);
+
+    // Pixels are the payload, referring to the value itself
+    auto header = std::string{};
+    auto payload = codec->encode(value, header);
+    const auto& encoded = value.as<I16Image>();
+    EXPECT_EQ(payload.data(),
+              reinterpret_cast<const std::byte*>(encoded.data.data()));
+    EXPECT_EQ(payload.size(), image.data.size() * sizeof(int16_t));
+
+    auto decoded = codec->decode(std::as_bytes(std::span{ header }), payload);
+    ASSERT_EQ(decoded.type(), mpk::mix::value::type_of<I16Image>());
+    EXPECT_EQ(decoded.as<I16Image>().size, image.size);
+    EXPECT_EQ(decoded.as<I16Image>().data, image.data);
+
+    // Sizes of headers and payloads are checked
+    EXPECT_THROW(codec->decode({}, payload), std::invalid_argument);
+    EXPECT_THROW(
+        codec->decode(std::as_bytes(std::span{ header }),
+                      payload.first(payload.size() - 1)),
+        std::invalid_argument);
+    const auto* colors_codec =
+        codecs.find(mpk::mix::value::type_of<ColorVec>());
+    ASSERT_NE(colors_codec, nullptr);
+    EXPECT_THROW(colors_codec->decode({}, payload.first(3)),
+                 std::invalid_argument);
+    const auto* size_codec =
+        codecs.find(mpk::mix::value::type_of<UintSize>());
+    ASSERT_NE(size_codec, nullptr);
+    EXPECT_THROW(size_codec->decode(payload.first(3), {}),
+                 std::invalid_argument);
+
+    EXPECT_THROW(add_snapshot_codecs(codecs), std::invalid_argument);
+}
@@ -10,13 +10,20 @@
 
 #pragma once
 
-#include "gc_visual/graph_evolution.hpp"
-
+#include "gc/disk_cache.hpp"
 #include "gc/graph_computation.hpp"
+#include "gc/graph_evolution.hpp"
 #include "gc/param_spec.hpp"
+#include "gc/progress_aggregator.hpp"
+#include "gc/result_cache.hpp"
+#include "gc/snapshot.hpp"
 
 #include <QThread>
 
+#include <chrono>
+#include <memory>
+#include <string>
+
 
 class ComputationThread :
     public QThread
@@ -35,7 +42,7 @@ public:
         -> bool;
 
     auto evolution() const
-        -> std::optional<gc_visual::GraphEvolution>;
+        -> std::optional<gc::GraphEvolution>;
 
 signals:
     auto progress(gc::NodeIndex inode, double node_progress)
@@ -54,11 +61,24 @@ public slots:
     auto advance_evolution(size_t skip = 0)
         -> void;
 
-    auto set_evolution(std::optional<gc_visual::GraphEvolution>)
+    auto set_evolution(std::optional<gc::GraphEvolution>)
         -> void;
 
+    // Replaces the graph. If `prev_nodes` maps some nodes of `g` to nodes
+    // of the current graph, results of nodes not affected by the change
+    // are kept (see `gc::adopt_result`). Otherwise, the graph is loaded
+    // anew, and the computation state is restored from the snapshot file,
+    // if it is one of the same graph; `graph_id` identifies the definition
+    // of the graph in snapshots (see `gc::save_snapshot`).
     auto set_graph(gc::ComputationGraph g,
-                   const gc::SourceInputs& provided_inputs)
+                   const gc::SourceInputs& provided_inputs,
+                   std::vector<std::optional<gc::NodeIndex>> prev_nodes = {},
+                   std::string graph_id = {})
+        -> void;
+
+    // Restricts computations to the nodes that `outputs` and evolution
+    // feedback sources depend on (see `gc::request_outputs`)
+    auto set_requested_outputs(std::vector<gc::EdgeOutputEnd> outputs)
         -> void;
 
     auto set_parameter(const gc::ParameterSpec&, const mpk::mix::value::Value&)
@@ -88,14 +108,42 @@ protected:
     auto run() -> void override;
 
 private:
-    auto try_compute(const auto& graph_progress) -> void;
-    auto clear_feedback() -> void;
-    auto set_feedback() -> void;
+    auto try_compute(auto& graph_progress) -> void;
+
+    auto apply_requested_outputs() -> void;
+
+    auto save_snapshot_if_due() -> void;
 
     bool ok_;
     std::stop_source stop_source_;
     gc::Computation computation_;
-    std::optional<gc_visual::GraphEvolution> evolution_;
+    std::optional<gc::GraphEvolution> evolution_;
+
+    // Collects progress of nodes, which is passed on to `progress`
+    // at a fixed rate
+    gc::ProgressAggregator progress_aggregator_;
+
+    // If set, only nodes these outputs depend on are computed
+    std::optional<std::vector<gc::EdgeOutputEnd>> requested_outputs_;
+
+    // Used in the non-evolution mode, so that revisiting parameter values
+    // does not recompute nodes
+    std::shared_ptr<gc::ResultCache> cache_;
+
+    // Set if the GC_CACHE_DIR environment variable specifies
+    // the persistent cache directory
+    std::shared_ptr<gc::DiskCache> disk_cache_;
+
+    // Set if the GC_SNAPSHOT_FILE environment variable specifies the file
+    // the state of the computation is periodically saved to during
+    // evolution, and restored from when a graph is set
+    gc::SnapshotCodecs snapshot_codecs_;
+    std::unique_ptr<gc::SnapshotWriter> snapshot_writer_;
+    std::chrono::steady_clock::time_point snapshot_time_;
+    std::string graph_id_;
+
+    // Number of evolution steps computed since the reset
+    size_t evolution_step_ = 0;
 
     // Zero value is used in a non-evolution mode, and a positive value -
     // in the feedback-driven evolution mode
@@ -22,6 +22,8 @@
 
 #include <QObject>
 
+#include <map>
+
 class GraphBroker final :
     public QObject
 {
@@ -59,7 +61,16 @@ public:
         -> const mpk::mix::value::Value&;
 
     auto evolution() const
-        -> std::optional<gc_visual::GraphEvolution>;
+        -> std::optional<gc::GraphEvolution>;
+
+    // Requested outputs are those bound to visible widgets; nodes none of
+    // them depends on are not computed (see `gc::request_outputs`). Each
+    // `request_output` call must be paired with a `release_output` call.
+    auto request_output(gc::EdgeOutputEnd output)
+        -> void;
+
+    auto release_output(gc::EdgeOutputEnd output)
+        -> void;
 
 signals:
     auto output_updated(gc::EdgeOutputEnd output)
@@ -93,4 +104,8 @@ private:
     gc_visual::BindingResolver binding_resolver_;
 
     gc::ComputationResult computation_result_;
+
+    // Number of `request_output` calls not paired with `release_output`
+    // calls yet, for each requested output
+    std::map<gc::EdgeOutputEnd, size_t> requested_outputs_;
 };
@@ -14,6 +14,8 @@
 
 #include "config_spec.hpp"
 
+#include <yaml-cpp/node/node.h>
+
 #include <QMainWindow>
 #include <QSignalMapper>
 
@@ -54,6 +56,10 @@ private:
 
     ComputationThread computation_thread_;
     gc_visual::ConfigSpecification spec_;
+
+    // The `graph` section of the last loaded file; nodes defined the same
+    // way in the next file keep their results
+    YAML::Node graph_config_;
     QSignalMapper* recents_mapper_;
     QMenu* recent_files_;
 
@@ -12,6 +12,8 @@
 
 #include "gc_visual/graph_broker_fwd.hpp"
 
+#include "gc/edge.hpp"
+
 #include <yaml-cpp/node/node.h>
 
 #include <QWidget>
@@ -29,4 +31,14 @@ public:
         QWidget* parent = nullptr);
 
     static auto supports_type(const std::string& type) -> bool;
+
+protected:
+    // The output is requested from the broker while the widget is visible
+    auto showEvent(QShowEvent* event) -> void override;
+    auto hideEvent(QHideEvent* event) -> void override;
+
+private:
+    GraphBroker* broker_;
+    gc::EdgeOutputEnd port_;
+    bool requested_{};
 };
@@ -10,16 +10,52 @@
 
 #include "gc_visual/computation_thread.hpp"
 
-#include "common/compiler_diagnostic.hpp"
+#include "gc_app/value_fingerprint.hpp"
+
+#include "gc_types/snapshot_codecs.hpp"
+#include "gc_types/value_size.hpp"
+
 #include "mpk/mix/func_ref/func_ref.hpp"
 #include "mpk/mix/util/overloads.hpp"
 
 #include <QtGlobal>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <stdexcept>
+
+namespace {
+
+constexpr size_t result_cache_capacity = 256 << 20;
+
+constexpr uint64_t disk_cache_capacity = uint64_t{1} << 30;
+
+// Node progress is passed on to the GUI at most this often
+constexpr auto progress_report_period = std::chrono::milliseconds{ 50 };
+
+// During evolution, the state is saved at most this often
+constexpr auto snapshot_period = std::chrono::minutes{ 1 };
+
+} // anonymous namespace
+
 ComputationThread::ComputationThread(QObject* parent) :
     QThread{ parent },
-    ok_{ false }
+    ok_{ false },
+    cache_{ std::make_shared<gc::ResultCache>(result_cache_capacity,
+                                              gc_types::value_size,
+                                              gc_app::value_fingerprint) }
 {
+    if (const auto* cache_dir = std::getenv("GC_CACHE_DIR"))
+        disk_cache_ = std::make_shared<gc::DiskCache>(
+            cache_dir, disk_cache_capacity);
+
+    gc_types::add_snapshot_codecs(snapshot_codecs_);
+    if (const auto* snapshot_file = std::getenv("GC_SNAPSHOT_FILE"))
+        snapshot_writer_ = std::make_unique<gc::SnapshotWriter>(
+            snapshot_file, snapshot_codecs_);
+
     connect(this, &ComputationThread::started,
             this, &ComputationThread::on_started);
     connect(this, &ComputationThread::finished,
@@ -58,7 +94,7 @@ auto ComputationThread::ok()
 { return ok_; }
 
 auto ComputationThread::evolution() const
-    -> std::optional<gc_visual::GraphEvolution>
+    -> std::optional<gc::GraphEvolution>
 { return evolution_; }
 
 auto ComputationThread::reset_computation()
@@ -66,9 +102,8 @@ auto ComputationThread::reset_computation()
 {
     stop();
     skip_ = 0;
-    auto& res = computation_.result;
-    res.computation_ts = gc::Timestamp{};
-    std::ranges::fill(res.node_ts, gc::Timestamp{});
+    evolution_step_ = 0;
+    gc::reset_result(computation_.result);
     start_computation();
 }
 
@@ -86,20 +121,58 @@ auto ComputationThread::advance_evolution(size_t skip)
 }
 
 auto ComputationThread::set_evolution(
-                std::optional<gc_visual::GraphEvolution> evolution)
+                std::optional<gc::GraphEvolution> evolution)
     -> void
 {
     stop();
     evolution_ = evolution;
     skip_ = 0;
+    apply_requested_outputs();
 }
 
-auto ComputationThread::set_graph(gc::ComputationGraph g,
-                                  const gc::SourceInputs& provided_inputs)
+auto ComputationThread::set_graph(
+                gc::ComputationGraph g,
+                const gc::SourceInputs& provided_inputs,
+                std::vector<std::optional<gc::NodeIndex>> prev_nodes,
+                std::string graph_id)
     -> void
 {
     stop();
-    computation_ = gc::computation(std::move(g), provided_inputs);
+    auto c = gc::computation(std::move(g), provided_inputs);
+    gc::enable_versions(c.source_inputs);
+    graph_id_ = std::move(graph_id);
+    auto reloaded = std::ranges::any_of(
+        prev_nodes, [](const auto& prev) { return prev.has_value(); });
+    if (reloaded)
+        gc::adopt_result(c, std::move(computation_), prev_nodes);
+    else
+    {
+        evolution_step_ = 0;
+        if (snapshot_writer_ &&
+            std::filesystem::exists(snapshot_writer_->path()))
+        {
+            // The snapshot may be one of another graph
+            try
+            {
+                evolution_step_ = gc::restore_snapshot(
+                    c, snapshot_writer_->path(), snapshot_codecs_, graph_id_);
+            }
+            catch (gc::SnapshotMismatch&)
+            {}
+        }
+    }
+    computation_ = std::move(c);
+    requested_outputs_.reset();
+    cache_->clear();
+}
+
+auto ComputationThread::set_requested_outputs(
+                std::vector<gc::EdgeOutputEnd> outputs)
+    -> void
+{
+    stop();
+    requested_outputs_ = std::move(outputs);
+    apply_requested_outputs();
 }
 
 auto ComputationThread::set_parameter(const gc::ParameterSpec& spec,
@@ -115,6 +188,7 @@ auto ComputationThread::set_parameter(const gc::ParameterSpec& spec,
             {
                 computation_.source_inputs
                     .values[i.input].set(spec.path, value);
+                gc::touch(computation_.source_inputs, i.input);
             },
             [&](const gc::NodeOutputSpec& o)
             {
@@ -124,14 +198,22 @@ auto ComputationThread::set_parameter(const gc::ParameterSpec& spec,
                 assert(node_outputs.index_range().contains(o.output.port));
                 node_outputs[o.output.port].set(spec.path, value);
 
+                // The edited output no longer matches its fingerprint; if
+                // the node recomputes the value it had before the edit,
+                // its consumers have to be recomputed too
+                if (!res.output_fingerprints.empty())
+                    res.output_fingerprints[o.output.node] = 0;
+
                 for (const auto& e : computation_.graph.edges)
                 {
                     if (e.from != o.output)
                         continue;
 
+                    // Node inputs bound to upstream outputs hold no values,
+                    // so store the whole updated output value.
                     auto node_inputs = group(res.inputs, e.to.node);
                     assert(node_inputs.index_range().contains(e.to.port));
-                    node_inputs[e.to.port].set(spec.path, value);
+                    node_inputs[e.to.port] = node_outputs[o.output.port];
 
                     res.updated_inputs.insert(e.to);
                 }
@@ -210,7 +292,15 @@ auto ComputationThread::run()
             [this](gc::NodeIndex inode, double node_progress)
         { emit progress(inode, node_progress); };
 
-        try_compute(graph_progress);
+        // Nodes store progress in the aggregator, and the reporter
+        // samples it, so that nodes never wait for signal emission
+        progress_aggregator_.reset(computation_.graph.nodes.size().v);
+        auto reporter = gc::ProgressReporter{
+            progress_aggregator_,
+            gc::GraphProgress{ &graph_progress },
+            progress_report_period };
+
+        try_compute(progress_aggregator_);
     }
     else
     {
@@ -219,21 +309,45 @@ auto ComputationThread::run()
 
         for (size_t i=0; i<skip_; ++i)
         {
-            set_feedback();
+            gc::set_feedback(computation_.result, *evolution_);
             try_compute(graph_progress);
             if (!ok_)
                 break;
+            ++evolution_step_;
+            save_snapshot_if_due();
         }
     }
 
-    clear_feedback();
+    gc::clear_feedback(computation_.result);
 }
 
-auto ComputationThread::try_compute(const auto& graph_progress) -> void
+auto ComputationThread::save_snapshot_if_due() -> void
+{
+    if (!snapshot_writer_)
+        return;
+
+    // Only copying values pauses the computation;
+    // the snapshot is written by the writer thread
+    auto now = std::chrono::steady_clock::now();
+    if (now - snapshot_time_ < snapshot_period)
+        return;
+    snapshot_time_ = now;
+    snapshot_writer_->save(
+        gc::take_snapshot(computation_, evolution_step_, graph_id_));
+}
+
+auto ComputationThread::try_compute(auto& graph_progress) -> void
 {
     ok_ = false;
+    computation_.result.cache = skip_ == 0 ? cache_ : nullptr;
+
+    // Evolution steps change their outputs anyway, so hashing them
+    // for the early cutoff would only cost a pass over each output
+    computation_.result.fingerprint =
+        skip_ == 0 ? gc_app::value_fingerprint : gc::ValueFingerprint{};
+    computation_.result.disk_cache = disk_cache_;
     try {
-        ok_ = compute(
+        ok_ = compute_dirty(
             computation_, stop_source_.get_token(), &graph_progress);
     }
     catch (std::exception& e)
@@ -242,30 +356,18 @@ auto ComputationThread::try_compute(const auto& graph_progress) -> void
     }
 }
 
-auto ComputationThread::clear_feedback() -> void
-{
-    auto& res = computation_.result;
-    res.updated_inputs.clear();
-}
-
-auto ComputationThread::set_feedback() -> void
+auto ComputationThread::apply_requested_outputs() -> void
 {
-    auto& res = computation_.result;
-
-    for (auto& fb : evolution_->feedback)
+    if (!requested_outputs_)
     {
-        const auto& src_end = fb.source_output.output;
-
-        GCLIB_DIAGNOSTIC_PUSH();
-        GCLIB_DISABLE_DANGLING_REFERENCE();
-        const auto& src_val = group(res.outputs, src_end.node)[src_end.port];
-        GCLIB_DIAGNOSTIC_POP();
-
-        for (const auto& dst_end : fb.sink_input.inputs)
-        {
-            auto& dst_val = group(res.inputs, dst_end.node)[dst_end.port];
-            dst_val = src_val;
-            res.updated_inputs.insert(dst_end);
-        }
+        gc::request_all_outputs(computation_.result);
+        return;
     }
+
+    // Feedback sources have to be computed for the evolution to proceed
+    auto outputs = *requested_outputs_;
+    if (evolution_)
+        for (const auto& fb : evolution_->feedback)
+            outputs.push_back(fb.source);
+    gc::request_outputs(computation_, outputs);
 }
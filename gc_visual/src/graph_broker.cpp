@@ -10,6 +10,8 @@
 
 #include "gc_visual/graph_broker.hpp"
 
+#include <algorithm>
+
 namespace {
 
 template<mpk::mix::StrongGroupedType SG, typename Port>
@@ -25,6 +27,16 @@ auto group_value(gc::NodeIndex node_index,
     return values[port_index];
 }
 
+auto output_keys(const std::map<gc::EdgeOutputEnd, size_t>& outputs)
+    -> std::vector<gc::EdgeOutputEnd>
+{
+    auto result = std::vector<gc::EdgeOutputEnd>{};
+    result.reserve(outputs.size());
+    for (const auto& [output, count] : outputs)
+        result.push_back(output);
+    return result;
+}
+
 } // anonymous namespace
 
 
@@ -81,12 +93,46 @@ auto GraphBroker::get_port_value(gc::EdgeOutputEnd port) const
 
 auto GraphBroker::get_port_value(gc::EdgeInputEnd port) const
     -> const mpk::mix::value::Value&
-{ return group_value(port.node, port.port, computation_result_.inputs); }
+{
+    // Inputs connected to upstream outputs are not stored separately
+    const auto& edges = computation_thread_.computation().graph.edges;
+    auto it = std::ranges::find(edges, port, &gc::Edge::to);
+    if (it != edges.end() &&
+        !computation_result_.updated_inputs.contains(port))
+        return get_port_value(it->from);
+
+    return group_value(port.node, port.port, computation_result_.inputs);
+}
 
 auto GraphBroker::evolution() const
-    -> std::optional<gc_visual::GraphEvolution>
+    -> std::optional<gc::GraphEvolution>
 { return computation_thread_.evolution(); }
 
+auto GraphBroker::request_output(gc::EdgeOutputEnd output)
+    -> void
+{
+    if (requested_outputs_[output]++ > 0)
+        return;
+
+    // The output may be outdated if it has not been requested before
+    computation_thread_.set_requested_outputs(
+        output_keys(requested_outputs_));
+    computation_thread_.start_computation();
+}
+
+auto GraphBroker::release_output(gc::EdgeOutputEnd output)
+    -> void
+{
+    auto it = requested_outputs_.find(output);
+    assert(it != requested_outputs_.end());
+    if (--it->second > 0)
+        return;
+
+    requested_outputs_.erase(it);
+    computation_thread_.set_requested_outputs(
+        output_keys(requested_outputs_));
+}
+
 auto GraphBroker::advance_evolution(size_t skip)
     -> void
 { computation_thread_.advance_evolution(skip); }
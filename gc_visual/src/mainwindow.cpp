@@ -12,7 +12,6 @@
 
 #include "gc_visual/widgets/computation_progress_widget.hpp"
 #include "gc_visual/graph_broker.hpp"
-#include "gc_visual/graph_evolution.hpp"
 #include "gc_visual/parse_layout.hpp"
 
 #include "gc_app/node_registry.hpp"
@@ -23,7 +22,9 @@
 
 #include "gc/computation_context.hpp"
 #include "gc/computation_node_registry.hpp"
+#include "gc/yaml/match_graph_nodes.hpp"
 #include "gc/yaml/parse_graph.hpp"
+#include "gc/yaml/parse_graph_evolution.hpp"
 
 #include <yaml-cpp/yaml.h>
 
@@ -277,11 +278,11 @@ auto MainWindow::load(const gc_visual::ConfigSpecification& spec)
         auto [g, provided_inputs, node_map, input_names] =
             gc::yaml::parse_graph(graph_config, context);
 
-        std::optional<gc_visual::GraphEvolution> evolution;
+        std::optional<gc::GraphEvolution> evolution;
         if (auto evolution_config = config["evolution"])
         {
-            evolution = gc_visual::parse_graph_evolution(
-                evolution_config, context, g, node_map, input_names);
+            evolution = gc::yaml::parse_graph_evolution(
+                evolution_config, g, node_map);
         }
 
         // Current central widget likely binds to signal from the computation
@@ -292,8 +293,14 @@ auto MainWindow::load(const gc_visual::ConfigSpecification& spec)
         setCentralWidget(new QWidget);
         delete oldCentralWidget;
 
-        // Compile and compute the graph
-        computation_thread_.set_graph(std::move(g), provided_inputs);
+        // Compile and compute the graph, keeping results of nodes
+        // not affected by changes since the last load
+        auto prev_nodes =
+            gc::yaml::match_graph_nodes(graph_config, graph_config_);
+        computation_thread_.set_graph(
+            std::move(g), provided_inputs, std::move(prev_nodes),
+            YAML::Dump(graph_config));
+        graph_config_ = YAML::Clone(graph_config);
         computation_thread_.set_evolution(evolution);
 
         connect(
@@ -114,6 +114,7 @@ ImageMetricsVisualizer::ImageMetricsVisualizer(GraphBroker* broker,
         if (holds_alternative<gc::NodeOutputSpec>(param_spec.io))
         {
             auto output = get<gc::NodeOutputSpec>(param_spec.io).output;
+            broker->request_output(output);
             QObject::connect(
                 broker, &GraphBroker::output_updated,
                 [output, broker, param_spec, view](gc::EdgeOutputEnd updated)
@@ -24,7 +24,9 @@
 #include "mpk/mix/util/throw.hpp"
 
 #include <QBoxLayout>
+#include <QHideEvent>
 #include <QLabel>
+#include <QShowEvent>
 
 
 using namespace std::string_view_literals;
@@ -86,7 +88,8 @@ GraphOutputVisualizer::GraphOutputVisualizer(const std::string& type,
                                              GraphBroker* broker,
                                              const YAML::Node& item_node,
                                              QWidget* parent) :
-    QWidget{ parent }
+    QWidget{ parent },
+    broker_{ broker }
 {
     // Resolve output port binding
     auto node_port_str = item_node["bind"].as<std::string>();
@@ -95,6 +98,7 @@ GraphOutputVisualizer::GraphOutputVisualizer(const std::string& type,
                                     broker->named_nodes(),
                                     broker->node_indices(),
                                     gc::Output);
+    port_ = port;
 
     auto* visualizer = visualizer_factory_map().at(type)(
         type, port, broker, item_node);
@@ -125,3 +129,25 @@ auto GraphOutputVisualizer::supports_type(const std::string& type) -> bool
 {
     return visualizer_factory_map().contains(type);
 }
+
+auto GraphOutputVisualizer::showEvent(QShowEvent* event) -> void
+{
+    QWidget::showEvent(event);
+
+    // Spontaneous events come, e.g., when the window is minimized;
+    // the output remains requested then.
+    if (event->spontaneous() || requested_)
+        return;
+    requested_ = true;
+    broker_->request_output(port_);
+}
+
+auto GraphOutputVisualizer::hideEvent(QHideEvent* event) -> void
+{
+    QWidget::hideEvent(event);
+
+    if (event->spontaneous() || !requested_)
+        return;
+    requested_ = false;
+    broker_->release_output(port_);
+}
@@ -93,6 +93,7 @@ public:
         if (holds_alternative<gc::NodeOutputSpec>(param_spec.io))
         {
             auto output = get<gc::NodeOutputSpec>(param_spec.io).output;
+            broker->request_output(output);
             QObject::connect(
                 broker, &GraphBroker::output_updated,
                 [output, broker, param_spec, this](gc::EdgeOutputEnd updated)
@@ -15,6 +15,9 @@
 
 #include "gc_types/image.hpp"
 
+#include <optional>
+#include <stop_token>
+
 namespace sieve {
 
 auto image_metrics(const gc_types::I8Image& img,
@@ -22,4 +25,12 @@ auto image_metrics(const gc_types::I8Image& img,
                    ImageMetricSet metric_types)
     -> ImageMetrics;
 
+// Cancellable version of `image_metrics`: image rows are scanned in blocks,
+// and nothing is returned if a stop is requested.
+auto image_metrics(const gc_types::I8Image& img,
+                   I8Range state_range,
+                   ImageMetricSet metric_types,
+                   const std::stop_token& stoken)
+    -> std::optional<ImageMetrics>;
+
 } // namespace sieve
@@ -10,6 +10,8 @@
 
 #include "sieve/algorithms/image_metrics.hpp"
 
+#include "gc/cancellation.hpp"
+
 #include <ranges>
 
 namespace sieve {
@@ -25,7 +27,9 @@ auto normalize(const std::vector<uint32_t>& v, double factor)
     return std::vector<double>(result.begin(), result.end());
 }
 
-auto histogram(const gc_types::I8Image& img, I8Range range)
+auto histogram(const gc_types::I8Image& img,
+               I8Range range,
+               gc::CancellationCheckpoint& checkpoint)
     -> std::vector<double>
 {
     int length = range.length();
@@ -39,20 +43,31 @@ auto histogram(const gc_types::I8Image& img, I8Range range)
         return std::vector<double>(length, 0.);
 
     std::vector<uint32_t> counters(length, 0);
-    for (auto v : img.data)
+    auto width = img.size.width;
+    const auto* row = img.data.data();
+    for (auto y=0u; y<img.size.height; ++y, row+=width)
     {
-        if (v < first || v > last)
-            // Should not really hapen and indicates an invalid image
-            // since it has out-of-range pixels
-            continue;
+        if (checkpoint())
+            return {};
 
-        ++counters[v - first];
+        for (auto x=0u; x<width; ++x)
+        {
+            auto v = row[x];
+            if (v < first || v > last)
+                // Should not really hapen and indicates an invalid image
+                // since it has out-of-range pixels
+                continue;
+
+            ++counters[v - first];
+        }
     }
 
     return normalize(counters, 1./img.data.size());
 }
 
-auto edge_histogram(const gc_types::I8Image& img, I8Range range)
+auto edge_histogram(const gc_types::I8Image& img,
+                    I8Range range,
+                    gc::CancellationCheckpoint& checkpoint)
     -> std::vector<double>
 {
     size_t length = range.length();
@@ -86,6 +101,9 @@ auto edge_histogram(const gc_types::I8Image& img, I8Range range)
     const auto* row = img.data.data();
     for (auto y=0u; y<height; ++y, prev_row=row, row+=width)
     {
+        if (checkpoint())
+            return {};
+
         for (auto x=0u; x+1<width; ++x)
         {
             process(row[x], row[x+1]);
@@ -104,7 +122,9 @@ struct ScalarStats final
     int64_t count{};
 };
 
-auto plateau_avg_size(const gc_types::I8Image& img, I8Range range)
+auto plateau_avg_size(const gc_types::I8Image& img,
+                      I8Range range,
+                      gc::CancellationCheckpoint& checkpoint)
     -> std::vector<double>
 {
     int length = range.length();
@@ -157,11 +177,19 @@ auto plateau_avg_size(const gc_types::I8Image& img, I8Range range)
     auto h = img.size.height;
 
     for (size_t row=0, i0=0; row<h; ++row, i0+=w)
+    {
+        if (checkpoint())
+            return {};
         compute_line(i0, i0+w, 1);
+    }
 
     auto h_w = h*w;
     for (size_t col=0; col<h; ++col)
+    {
+        if (checkpoint())
+            return {};
         compute_line(col, col+h_w, w);
+    }
 
     auto result = stats |
         std::views::transform(
@@ -179,14 +207,29 @@ auto image_metrics(const gc_types::I8Image& img,
                    I8Range state_range,
                    ImageMetricSet metric_types)
     -> ImageMetrics
+{ return *image_metrics(img, state_range, metric_types, {}); }
+
+auto image_metrics(const gc_types::I8Image& img,
+                   I8Range state_range,
+                   ImageMetricSet metric_types,
+                   const std::stop_token& stoken)
+    -> std::optional<ImageMetrics>
 {
+    // Rows (and columns) are counted as work items
+    auto checkpoint = gc::CancellationCheckpoint{
+        stoken, gc::cancellation_rows(img.size.width) };
+
     auto result = ImageMetrics{};
     if (metric_types.contains(ImageMetric::StateHistogram))
-        result.histogram = histogram(img, state_range);
+        result.histogram = histogram(img, state_range, checkpoint);
     if (metric_types.contains(ImageMetric::EdgeHistogram))
-        result.edge_histogram = edge_histogram(img, state_range);
+        result.edge_histogram =
+            edge_histogram(img, state_range, checkpoint);
     if (metric_types.contains(ImageMetric::PlateauAvgSize))
-        result.plateau_avg_size = plateau_avg_size(img, state_range);
+        result.plateau_avg_size =
+            plateau_avg_size(img, state_range, checkpoint);
+    if (checkpoint.stopped())
+        return std::nullopt;
     return result;
 }
 
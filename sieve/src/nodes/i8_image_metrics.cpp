@@ -52,7 +52,7 @@ public:
     auto compute_outputs(
             gc::OutputValues result,
             gc::ConstInputValues inputs,
-            const std::stop_token&,
+            const std::stop_token& stoken,
             const gc::NodeProgress& progress) const
         -> bool override
     {
@@ -62,8 +62,11 @@ public:
         auto min_state = inputs[1_gc_i].convert_to<int>();
         auto state_count = inputs[2_gc_i].convert_to<int>();
         auto metric_types = inputs[3_gc_i].as<ImageMetricSet>();
-        result[0_gc_o] =
-            image_metrics(image, {min_state, state_count}, metric_types);
+        auto metrics = image_metrics(
+            image, {min_state, state_count}, metric_types, stoken);
+        if (!metrics)
+            return false;
+        result[0_gc_o] = std::move(*metrics);
 
         if (progress)
             progress(1);
@@ -20,6 +20,8 @@
 
 #include <gtest/gtest.h>
 
+#include <stop_token>
+
 
 using namespace gc_types;
 using namespace sieve;
@@ -54,3 +56,26 @@ TEST(Sieve_Node, ImageMetrics)
     node->compute_outputs(outputs, inputs, {}, {});
     ASSERT_EQ(outputs[0].type(), mpk::mix::value::type_of<ImageMetrics>());
 }
+
+TEST(Sieve_Node, ImageMetricsStop)
+{
+    auto node = make_i8_image_metrics({}, {});
+
+    mpk::mix::value::ValueVec inputs(4);
+    mpk::mix::value::ValueVec outputs(1);
+
+    node->default_inputs(inputs);
+    inputs[0] = I8Image{
+        .size = {1024, 1024},
+        .data = std::vector<int8_t>(1024*1024, 0)
+    };
+
+    auto stop_source = std::stop_source{};
+    stop_source.request_stop();
+    EXPECT_FALSE(
+        node->compute_outputs(outputs, inputs, stop_source.get_token(), {}));
+    EXPECT_FALSE(outputs[0].type());
+
+    EXPECT_TRUE(node->compute_outputs(outputs, inputs, {}, {}));
+    ASSERT_EQ(outputs[0].type(), mpk::mix::value::type_of<ImageMetrics>());
+}